@@ -0,0 +1,83 @@
+#ifndef K4EDM4HEP2LCIOCONV_CAPACITYPLANNER_H
+#define K4EDM4HEP2LCIOCONV_CAPACITYPLANNER_H
+
+#include "k4EDM4hep2LcioConv/MappingUtils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace k4EDM4hep2LcioConv {
+
+  /**
+   * Simple capacity planning for containers whose final size is not known
+   * before they are filled, but that have similar sizes from event to event
+   * (e.g. the object mappings that are filled from several collections).
+   *
+   * The sizes of the containers are recorded (by name) after each event and
+   * used as capacity hints for the next events. The hints follow increasing
+   * sizes immediately, but only decay slowly for decreasing sizes, such that
+   * a few small events do not lead to reallocations for the next large one.
+   */
+  class CapacityPlanner {
+  public:
+    struct Stats {
+      std::size_t nEvents {0};     ///< The number of finished events
+      std::size_t nRecorded {0};   ///< The number of recorded sizes for which a hint was available
+      std::size_t nSufficient {0}; ///< The number of times a hint was at least as large as the recorded size
+      std::size_t nReserved {0};   ///< The total number of elements that have been reserved based on hints
+    };
+
+    /// Get the capacity hint for a given name (0 if nothing is known yet)
+    std::size_t hint(const std::string& name) const
+    {
+      if (const auto it = m_hints.find(name); it != m_hints.end()) {
+        return it->second;
+      }
+      return 0;
+    }
+
+    /// Reserve space in the passed map (or map-like) according to the current
+    /// capacity hint for the name
+    template<typename MapT>
+    void reserve(const std::string& name, MapT& map)
+    {
+      if (const auto n = hint(name); n > 0) {
+        detail::mapReserve(map, n);
+        m_stats.nReserved += n;
+      }
+    }
+
+    /// Record the size a container has reached in this event
+    void record(const std::string& name, std::size_t size)
+    {
+      auto [it, inserted] = m_hints.try_emplace(name, size);
+      if (inserted) {
+        return;
+      }
+
+      auto& hint = it->second;
+      m_stats.nRecorded++;
+      if (hint >= size) {
+        m_stats.nSufficient++;
+      }
+      hint = std::max(size, hint - hint / DecayDenominator);
+    }
+
+    /// Mark the end of an event
+    void endEvent() { m_stats.nEvents++; }
+
+    const Stats& stats() const { return m_stats; }
+
+  private:
+    /// Hints decay by 1 / DecayDenominator per event if the sizes decrease
+    constexpr static std::size_t DecayDenominator = 16;
+
+    std::unordered_map<std::string, std::size_t> m_hints {};
+    Stats m_stats {};
+  };
+
+} // namespace k4EDM4hep2LcioConv
+
+#endif // K4EDM4HEP2LCIOCONV_CAPACITYPLANNER_H
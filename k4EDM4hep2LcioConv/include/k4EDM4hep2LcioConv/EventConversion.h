@@ -0,0 +1,72 @@
+#ifndef K4EDM4HEP2LCIOCONV_EVENTCONVERSION_H
+#define K4EDM4HEP2LCIOCONV_EVENTCONVERSION_H
+
+// Lightweight header for code that only converts complete events. It only
+// forward declares the LCIO and podio types, such that including it does not
+// pull in all the LCIO and EDM4hep headers. Use k4Lcio2EDM4hepConv.h or
+// k4EDM4hep2LcioConv.h to access the full conversion functionality.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace podio {
+  class Frame;
+}
+
+namespace EVENT {
+  class LCEvent;
+  class LCRunHeader;
+} // namespace EVENT
+
+namespace IMPL {
+  class LCEventImpl;
+}
+
+namespace LCIO2EDM4hepConv {
+
+  /*
+   * Convert a LCRunHeader to EDM4hep as a frame.
+   */
+  podio::Frame convertRunHeader(EVENT::LCRunHeader* rheader);
+
+  /**
+   * Convert a complete LCEvent from LCIO to EDM4hep.
+   *
+   * A second, optional argument can be passed to limit the collections to
+   * convert to the subset that is passed. NOTE: There is an implicit assumption
+   * here that collsToConvert only contains collection names that are present in
+   * the passed evt. There is no exception handling internally to guard against
+   * collections that are missing.
+   */
+  podio::Frame convertEvent(EVENT::LCEvent* evt, const std::vector<std::string>& collsToConvert = {});
+
+} // namespace LCIO2EDM4hepConv
+
+namespace EDM4hep2LCIOConv {
+
+  /**
+   * Convert an edm4hep event to an LCEvent. Using the returned event requires
+   * including IMPL/LCEventImpl.h
+   *
+   * Each thread re-uses one EventConverter for all calls, such that the
+   * conversion plan and the memory of the object mappings are kept between
+   * events.
+   */
+  std::unique_ptr<IMPL::LCEventImpl> convEvent(const podio::Frame& edmEvent);
+
+  /**
+   * Convert an edm4hep event to an LCEvent, using the passed metadata (e.g.
+   * for the CellIDEncoding strings). Also re-uses one EventConverter per
+   * thread, including the CellIDEncodings as long as the same metadata Frame
+   * is passed.
+   *
+   * NOTE: The metadata Frame is identified by its address, so its contents
+   * must not change between calls (which they usually do not during a run).
+   * Use an EventConverter and its setMetadata if they do.
+   */
+  std::unique_ptr<IMPL::LCEventImpl> convEvent(const podio::Frame& edmEvent, const podio::Frame& metadata);
+
+} // namespace EDM4hep2LCIOConv
+
+#endif // K4EDM4HEP2LCIOCONV_EVENTCONVERSION_H
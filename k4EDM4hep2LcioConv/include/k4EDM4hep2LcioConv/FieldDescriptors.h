@@ -0,0 +1,272 @@
+#ifndef K4EDM4HEP2LCIOCONV_FIELDDESCRIPTORS_H
+#define K4EDM4HEP2LCIOCONV_FIELDDESCRIPTORS_H
+
+// EDM4hep
+#include <edm4hep/CalorimeterHitCollection.h>
+#include <edm4hep/RawCalorimeterHitCollection.h>
+#include <edm4hep/SimCalorimeterHitCollection.h>
+#include <edm4hep/SimTrackerHitCollection.h>
+#include <edm4hep/TrackerHitCollection.h>
+
+// LCIO
+#include <IMPL/CalorimeterHitImpl.h>
+#include <IMPL/RawCalorimeterHitImpl.h>
+#include <IMPL/SimCalorimeterHitImpl.h>
+#include <IMPL/SimTrackerHitImpl.h>
+#include <IMPL/TrackerHitImpl.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace k4EDM4hep2LcioConv {
+
+  /// Combine the two 32 bit LCIO cellIDs into one 64 bit EDM4hep cellID. Both
+  /// are taken as unsigned, such that a negative cellID0 is not sign extended
+  /// into the upper 32 bits
+  constexpr uint64_t combineCellID(int cellID0, int cellID1)
+  {
+    return (uint64_t(uint32_t(cellID1)) << 32) | uint32_t(cellID0);
+  }
+
+  /// Get the lower 32 bits of an EDM4hep cellID as LCIO cellID0
+  constexpr int lowerCellID(uint64_t cellID) { return static_cast<int>(static_cast<uint32_t>(cellID)); }
+
+  /// Get the upper 32 bits of an EDM4hep cellID as LCIO cellID1
+  constexpr int upperCellID(uint64_t cellID) { return static_cast<int>(static_cast<uint32_t>(cellID >> 32)); }
+
+  static_assert(
+    lowerCellID(combineCellID(-2, 5)) == -2 && upperCellID(combineCellID(-2, 5)) == 5,
+    "A cellID0 with the highest bit set has to survive a roundtrip");
+  static_assert(
+    lowerCellID(combineCellID(7, -3)) == 7 && upperCellID(combineCellID(7, -3)) == -3,
+    "A cellID1 with the highest bit set has to survive a roundtrip");
+  static_assert(combineCellID(-1, 0) == 0xFFFFFFFFu, "cellID0 must not be sign extended");
+
+  namespace detail {
+    /// Accessors for the LCIO getters. If they are called with a pointer to a
+    /// concrete LCIO implementation type, the getter is called directly instead
+    /// of going through the virtual EVENT interface. Additional arguments (e.g.
+    /// the index of a contribution) are passed on to the getter.
+    namespace lcio_getters {
+#define K4EDM4HEP2LCIOCONV_LCIO_GETTER(GETTER)                \
+  struct GETTER {                                             \
+    template<typename LcioT, typename... Args>                \
+    static decltype(auto) get(const LcioT* obj, Args... args) \
+    {                                                         \
+      if constexpr (std::is_abstract_v<LcioT>) {              \
+        return obj->GETTER(args...);                          \
+      }                                                       \
+      else {                                                  \
+        return obj->LcioT::GETTER(args...);                   \
+      }                                                       \
+    }                                                         \
+  };
+
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getCellID0)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getCellID1)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getEnergy)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getEnergyError)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getTime)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getType)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getQuality)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getPosition)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getMomentum)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getCovMatrix)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getAmplitude)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getTimeStamp)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getEDep)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getEDepError)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getPathLength)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getLocation)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getD0)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getPhi)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getOmega)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getZ0)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getTanLambda)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getReferencePoint)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getNMCParticles)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getPDGCont)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getEnergyCont)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getTimeCont)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getStepPosition)
+      K4EDM4HEP2LCIOCONV_LCIO_GETTER(getParticleCont)
+
+#undef K4EDM4HEP2LCIOCONV_LCIO_GETTER
+    } // namespace lcio_getters
+
+    /// Descriptor for a scalar data member that is copied as is between LCIO
+    /// and EDM4hep. It holds the LCIO getter accessor and setter, the EDM4hep
+    /// getter and the member of the EDM4hep data struct.
+    template<typename LcioGetter, auto LcioSetter, auto EdmGetter, auto EdmMember>
+    struct ScalarField {
+      template<typename LcioT, typename EdmDataT>
+      static void toEdm(const LcioT* from, EdmDataT& to)
+      {
+        to.*EdmMember = LcioGetter::get(from);
+      }
+
+      template<typename EdmT, typename LcioImplT>
+      static void toLcio(const EdmT& from, LcioImplT* to)
+      {
+        (to->*LcioSetter)((from.*EdmGetter)());
+      }
+    };
+
+    /// Descriptor for the cellID, which is split into cellID0 and cellID1 in
+    /// LCIO
+    struct CellIDField {
+      template<typename LcioT, typename EdmDataT>
+      static void toEdm(const LcioT* from, EdmDataT& to)
+      {
+        to.cellID = combineCellID(lcio_getters::getCellID0::get(from), lcio_getters::getCellID1::get(from));
+      }
+
+      template<typename EdmT, typename LcioImplT>
+      static void toLcio(const EdmT& from, LcioImplT* to)
+      {
+        const uint64_t cellID = from.getCellID();
+        to->setCellID0(lowerCellID(cellID));
+        to->setCellID1(upperCellID(cellID));
+      }
+    };
+
+    /// A list of field descriptors that are copied in one go
+    template<typename... Fields>
+    struct FieldList {
+      /// Copy all described fields from an LCIO object into an EDM4hep data
+      /// struct
+      template<typename LcioT, typename EdmDataT>
+      static void toEdm(const LcioT* from, EdmDataT& to)
+      {
+        (Fields::toEdm(from, to), ...);
+      }
+
+      /// Copy all described fields from an EDM4hep object into an LCIO object
+      template<typename EdmT, typename LcioImplT>
+      static void toLcio(const EdmT& from, LcioImplT* to)
+      {
+        (Fields::toLcio(from, to), ...);
+      }
+    };
+  } // namespace detail
+
+  /// The fields that are copied one to one between LCIO and EDM4hep for a given
+  /// EDM4hep type. Everything that needs more treatment than that (positions,
+  /// covariance matrices, relations, ...) is handled by the converters
+  /// directly.
+  template<typename EdmT>
+  struct FieldDescriptor;
+
+  template<>
+  struct FieldDescriptor<edm4hep::CalorimeterHit>
+    : detail::FieldList<
+        detail::CellIDField,
+        detail::ScalarField<
+          detail::lcio_getters::getEnergy,
+          &IMPL::CalorimeterHitImpl::setEnergy,
+          &edm4hep::CalorimeterHit::getEnergy,
+          &edm4hep::CalorimeterHitData::energy>,
+        detail::ScalarField<
+          detail::lcio_getters::getEnergyError,
+          &IMPL::CalorimeterHitImpl::setEnergyError,
+          &edm4hep::CalorimeterHit::getEnergyError,
+          &edm4hep::CalorimeterHitData::energyError>,
+        detail::ScalarField<
+          detail::lcio_getters::getTime,
+          &IMPL::CalorimeterHitImpl::setTime,
+          &edm4hep::CalorimeterHit::getTime,
+          &edm4hep::CalorimeterHitData::time>,
+        detail::ScalarField<
+          detail::lcio_getters::getType,
+          &IMPL::CalorimeterHitImpl::setType,
+          &edm4hep::CalorimeterHit::getType,
+          &edm4hep::CalorimeterHitData::type>> {
+  };
+
+  template<>
+  struct FieldDescriptor<edm4hep::RawCalorimeterHit>
+    : detail::FieldList<
+        detail::CellIDField,
+        detail::ScalarField<
+          detail::lcio_getters::getAmplitude,
+          &IMPL::RawCalorimeterHitImpl::setAmplitude,
+          &edm4hep::RawCalorimeterHit::getAmplitude,
+          &edm4hep::RawCalorimeterHitData::amplitude>,
+        detail::ScalarField<
+          detail::lcio_getters::getTimeStamp,
+          &IMPL::RawCalorimeterHitImpl::setTimeStamp,
+          &edm4hep::RawCalorimeterHit::getTimeStamp,
+          &edm4hep::RawCalorimeterHitData::timeStamp>> {
+  };
+
+  template<>
+  struct FieldDescriptor<edm4hep::SimCalorimeterHit>
+    : detail::FieldList<
+        detail::CellIDField,
+        detail::ScalarField<
+          detail::lcio_getters::getEnergy,
+          &IMPL::SimCalorimeterHitImpl::setEnergy,
+          &edm4hep::SimCalorimeterHit::getEnergy,
+          &edm4hep::SimCalorimeterHitData::energy>> {
+  };
+
+  template<>
+  struct FieldDescriptor<edm4hep::SimTrackerHit>
+    : detail::FieldList<
+        detail::CellIDField,
+        detail::ScalarField<
+          detail::lcio_getters::getEDep,
+          &IMPL::SimTrackerHitImpl::setEDep,
+          &edm4hep::SimTrackerHit::getEDep,
+          &edm4hep::SimTrackerHitData::EDep>,
+        detail::ScalarField<
+          detail::lcio_getters::getTime,
+          &IMPL::SimTrackerHitImpl::setTime,
+          &edm4hep::SimTrackerHit::getTime,
+          &edm4hep::SimTrackerHitData::time>,
+        detail::ScalarField<
+          detail::lcio_getters::getPathLength,
+          &IMPL::SimTrackerHitImpl::setPathLength,
+          &edm4hep::SimTrackerHit::getPathLength,
+          &edm4hep::SimTrackerHitData::pathLength>,
+        detail::ScalarField<
+          detail::lcio_getters::getQuality,
+          &IMPL::SimTrackerHitImpl::setQuality,
+          &edm4hep::SimTrackerHit::getQuality,
+          &edm4hep::SimTrackerHitData::quality>> {
+  };
+
+  template<>
+  struct FieldDescriptor<edm4hep::TrackerHit>
+    : detail::FieldList<
+        detail::CellIDField,
+        detail::ScalarField<
+          detail::lcio_getters::getType,
+          &IMPL::TrackerHitImpl::setType,
+          &edm4hep::TrackerHit::getType,
+          &edm4hep::TrackerHitData::type>,
+        detail::ScalarField<
+          detail::lcio_getters::getQuality,
+          &IMPL::TrackerHitImpl::setQuality,
+          &edm4hep::TrackerHit::getQuality,
+          &edm4hep::TrackerHitData::quality>,
+        detail::ScalarField<
+          detail::lcio_getters::getTime,
+          &IMPL::TrackerHitImpl::setTime,
+          &edm4hep::TrackerHit::getTime,
+          &edm4hep::TrackerHitData::time>,
+        detail::ScalarField<
+          detail::lcio_getters::getEDep,
+          &IMPL::TrackerHitImpl::setEDep,
+          &edm4hep::TrackerHit::getEDep,
+          &edm4hep::TrackerHitData::eDep>,
+        detail::ScalarField<
+          detail::lcio_getters::getEDepError,
+          &IMPL::TrackerHitImpl::setEDepError,
+          &edm4hep::TrackerHit::getEDepError,
+          &edm4hep::TrackerHitData::eDepError>> {
+  };
+
+} // namespace k4EDM4hep2LcioConv
+
+#endif // K4EDM4HEP2LCIOCONV_FIELDDESCRIPTORS_H
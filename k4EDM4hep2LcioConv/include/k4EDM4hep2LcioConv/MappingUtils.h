@@ -1,8 +1,13 @@
 #ifndef K4EDM4HEP2LCIOCONV_MAPPINGUTILS_H
 #define K4EDM4HEP2LCIOCONV_MAPPINGUTILS_H
 
+#include <podio/ObjectID.h>
+
 #include <optional>
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <vector>
 #include <tuple>
 #include <unordered_map>
@@ -129,12 +134,62 @@ namespace k4EDM4hep2LcioConv {
     template<typename T, typename MappedT>
     constexpr static bool is_valid_mapped_type_v = is_eq_comparable<T, MappedT>;
 
+    /// Detectors for "map-like" types that carry their own (hash) indices and
+    /// hence can do lookups more efficiently than a linear search (see
+    /// IndexedVecMap below)
+    template<typename T>
+    using has_lookup_to = decltype(std::declval<const T&>().lookupTo(std::declval<key_t<T>>()));
+
+    template<typename T>
+    constexpr static bool has_lookup_to_v = det::is_detected_v<has_lookup_to, T>;
+
+    template<typename T>
+    using has_lookup_from = decltype(std::declval<const T&>().lookupFrom(std::declval<mapped_t<T>>()));
+
+    template<typename T>
+    constexpr static bool has_lookup_from_v = det::is_detected_v<has_lookup_from, T>;
+
+    /// Hash function that multiplies the (pointer) value with the golden
+    /// ratio (Fibonacci hashing) to get well mixed high bits. Users should use
+    /// the high bits of the result (e.g. by shifting) and not the low ones.
+    ///
+    /// Pointers to objects from the same allocator often form (piecewise)
+    /// arithmetic sequences, for which plain Fibonacci hashing can lead to
+    /// rather long probe sequences. Hence, some higher bits are folded into the
+    /// lower ones before the multiplication.
+    template<typename K>
+    struct FibonacciHash {
+      uint64_t operator()(const K& key) const noexcept
+      {
+        uint64_t hash;
+        if constexpr (std::is_pointer_v<K>) {
+          hash = reinterpret_cast<std::uintptr_t>(key);
+        }
+        else {
+          hash = std::hash<K> {}(key);
+        }
+        hash ^= (hash >> 4) ^ (hash >> 20);
+        return hash * UINT64_C(11400714819323198485);
+      }
+    };
+
+    /// Hash function for podio::ObjectIDs
+    struct ObjectIDHash {
+      std::size_t operator()(const podio::ObjectID& id) const noexcept
+      {
+        const auto collID = static_cast<uint64_t>(static_cast<uint32_t>(id.collectionID));
+        return std::hash<uint64_t> {}((collID << 32) | static_cast<uint32_t>(id.index));
+      }
+    };
+
     /**
      * Find the mapped-to object in a map provided a key object
      *
      * NOTE: This will use a potentially more efficient lookup for actual map
      * types (i.e. MapT::find). In that case it will have the time complexity of
-     * that. In case of a "map-like" (e.g. vector<tuple<K, V>>) it will be O(N).
+     * that. The same is true for "map-like" types that provide their own index
+     * (e.g. IndexedVecMap). In case of a "map-like" (e.g. vector<tuple<K, V>>)
+     * it will be O(N).
      */
     template<typename FromT, typename MapT, typename = std::enable_if_t<is_valid_key_type_v<FromT, key_t<MapT>>>>
     auto mapLookupTo(FromT keyObj, const MapT& map) -> std::optional<mapped_t<MapT>>
@@ -144,6 +199,9 @@ namespace k4EDM4hep2LcioConv {
           return it->second;
         }
       }
+      else if constexpr (has_lookup_to_v<MapT> && std::is_convertible_v<FromT, key_t<MapT>>) {
+        return map.lookupTo(keyObj);
+      }
       else {
         if (const auto& it = std::find_if(
               map.begin(), map.end(), [&keyObj](const auto& mapElem) { return std::get<0>(mapElem) == keyObj; });
@@ -158,12 +216,17 @@ namespace k4EDM4hep2LcioConv {
     /**
      * Find the mapped-from (or key object) in a "map" provided a mapped-to object
      *
-     * NOTE: This will always loop over potentially all elements in the provided
-     * map, so it is definitely O(N) regardless of the provided map type
+     * NOTE: This will loop over potentially all elements in the provided map,
+     * so it is O(N), unless the map type provides a reverse index itself (e.g.
+     * IndexedVecMap) in which case that will be used
      */
     template<typename ToT, typename MapT, typename = std::enable_if_t<is_valid_mapped_type_v<ToT, mapped_t<MapT>>>>
     auto mapLookupFrom(ToT mappedObj, const MapT& map) -> std::optional<key_t<MapT>>
     {
+      if constexpr (has_lookup_from_v<MapT>) {
+        return map.lookupFrom(mappedObj);
+      }
+
       // In this case we cannot use a potential find method for an actual map, but
       // looping over the map and doing the actual comparison will work
       if (const auto& it = std::find_if(
@@ -204,6 +267,31 @@ namespace k4EDM4hep2LcioConv {
       }
     }
 
+    /// Reserve space for at least n elements in a vector, but at least double
+    /// the current capacity if a reallocation is necessary
+    template<typename T>
+    void reserveGeometric(std::vector<T>& vec, std::size_t n)
+    {
+      if (n > vec.capacity()) {
+        vec.reserve(std::max(n, 2 * vec.capacity()));
+      }
+    }
+
+    template<typename T>
+    using has_reserve = decltype(std::declval<T&>().reserve(std::size_t {}));
+
+    /**
+     * Make room for n additional elements in a "map" if it supports that. This
+     * is a no-op for types without a reserve method.
+     */
+    template<typename MapT>
+    void mapReserve(MapT& map, std::size_t n)
+    {
+      if constexpr (det::is_detected_v<has_reserve, MapT>) {
+        map.reserve(map.size() + n);
+      }
+    }
+
     /// Helper type alias that can be used to detect whether a T can be used
     /// with std::get directly or whether it has to be dereferenced first
     template<typename T>
@@ -250,6 +338,380 @@ namespace k4EDM4hep2LcioConv {
   template<typename K, typename V>
   using VecMapT = std::vector<std::tuple<K, V>>;
 
+  /**
+   * A flat open-addressing hash map meant as a drop-in replacement for MapT in
+   * cases where the keys are pointers (e.g. LCIO objects).
+   *
+   * The elements are stored densely and in insertion order in a vector, which
+   * also defines the iteration order. The hash table itself only holds the
+   * keys and the positions of the corresponding elements, using linear probing
+   * and Fibonacci hashing on a power of two sized table. Compared to
+   * std::unordered_map this avoids one allocation per element and most of the
+   * pointer chasing during lookups.
+   *
+   * NOTE: Elements cannot be erased. As for a vector, iterators and references
+   * are invalidated by inserting new elements.
+   */
+  template<typename K, typename V, typename Hash = detail::FibonacciHash<K>>
+  class FlatMap {
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using container_type = std::vector<value_type>;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+    iterator begin() { return m_data.begin(); }
+    iterator end() { return m_data.end(); }
+    const_iterator begin() const { return m_data.begin(); }
+    const_iterator end() const { return m_data.end(); }
+
+    std::size_t size() const { return m_data.size(); }
+    bool empty() const { return m_data.empty(); }
+
+    /// Make room for at least n elements without rehashing. Grows the storage
+    /// geometrically, such that repeatedly reserving for a few more elements
+    /// does not lead to a reallocation every time
+    void reserve(std::size_t n)
+    {
+      detail::reserveGeometric(m_data, n);
+      if (needsGrowth(n)) {
+        rehash(slotCountFor(n));
+      }
+    }
+
+    /// Remove all elements but keep the allocated memory
+    void clear()
+    {
+      m_data.clear();
+      std::fill(m_slots.begin(), m_slots.end(), Slot {});
+    }
+
+    iterator find(const K& key)
+    {
+      const auto pos = findPos(key);
+      return pos == EmptyPos ? end() : begin() + pos;
+    }
+
+    const_iterator find(const K& key) const
+    {
+      const auto pos = findPos(key);
+      return pos == EmptyPos ? end() : begin() + pos;
+    }
+
+    std::size_t count(const K& key) const { return findPos(key) != EmptyPos; }
+
+    /// Insert a new element if the key is not yet present. Same return value
+    /// as std::unordered_map::emplace
+    template<typename KeyT, typename MappedT>
+    std::pair<iterator, bool> emplace(KeyT&& key, MappedT&& mapped)
+    {
+      if (m_slots.empty()) {
+        rehash(MinSlots);
+      }
+
+      const K k = std::forward<KeyT>(key);
+      auto index = probe(k);
+      if (m_slots[index].pos != EmptyPos) {
+        return {begin() + m_slots[index].pos, false};
+      }
+      // Only grow for keys that are actually inserted. The free slot that has
+      // been found is no longer valid after rehashing
+      if (needsGrowth(m_data.size() + 1)) {
+        rehash(slotCountFor(m_data.size() + 1));
+        index = probe(k);
+      }
+
+      m_slots[index] = Slot {k, static_cast<uint32_t>(m_data.size())};
+      m_data.emplace_back(k, std::forward<MappedT>(mapped));
+      return {end() - 1, true};
+    }
+
+  private:
+    constexpr static uint32_t EmptyPos = std::numeric_limits<uint32_t>::max();
+    constexpr static std::size_t MinSlots = 16;
+
+    struct Slot {
+      K key {};
+      uint32_t pos {EmptyPos};
+    };
+
+    /// Keep the load factor below 3/4 to keep the probe sequences short
+    bool needsGrowth(std::size_t n) const { return n * 4 > m_slots.size() * 3; }
+
+    static std::size_t slotCountFor(std::size_t n)
+    {
+      auto count = MinSlots;
+      while (n * 4 > count * 3) {
+        count *= 2;
+      }
+      return count;
+    }
+
+    std::size_t slotIndex(const K& key) const { return static_cast<std::size_t>(Hash {}(key) >> m_shift); }
+
+    /// Get the index of the slot holding key, or of the empty slot where it
+    /// would have to be inserted. Requires a non-empty table
+    std::size_t probe(const K& key) const
+    {
+      auto index = slotIndex(key);
+      while (m_slots[index].pos != EmptyPos && !(m_slots[index].key == key)) {
+        index = (index + 1) & (m_slots.size() - 1);
+      }
+      return index;
+    }
+
+    uint32_t findPos(const K& key) const
+    {
+      if (m_slots.empty()) {
+        return EmptyPos;
+      }
+      return m_slots[probe(key)].pos;
+    }
+
+    void rehash(std::size_t slotCount)
+    {
+      m_slots.assign(slotCount, Slot {});
+      m_shift = 64;
+      while (slotCount > 1) {
+        slotCount >>= 1;
+        m_shift--;
+      }
+
+      for (std::size_t pos = 0; pos < m_data.size(); ++pos) {
+        auto index = slotIndex(m_data[pos].first);
+        while (m_slots[index].pos != EmptyPos) {
+          index = (index + 1) & (m_slots.size() - 1);
+        }
+        m_slots[index] = Slot {m_data[pos].first, static_cast<uint32_t>(pos)};
+      }
+    }
+
+    container_type m_data {};
+    std::vector<Slot> m_slots {};
+    unsigned m_shift {64};
+  };
+
+  template<typename K, typename V>
+  using FlatMapT = FlatMap<K, V>;
+
+  /**
+   * Reverse index from podio::ObjectID to a position in an IndexedVecMap based
+   * on hashing the ObjectIDs. Works for arbitrary (and sparse) ObjectIDs
+   */
+  class HashedObjectIDIndex {
+  public:
+    void reserve(std::size_t n) { m_index.reserve(n); }
+    void clear() { m_index.clear(); }
+
+    /// Index the position of an object. Existing entries are not overwritten
+    void insert(const podio::ObjectID& id, std::size_t pos) { m_index.emplace(id, pos); }
+
+    std::optional<std::size_t> find(const podio::ObjectID& id) const
+    {
+      if (const auto it = m_index.find(id); it != m_index.end()) {
+        return it->second;
+      }
+      return std::nullopt;
+    }
+
+  private:
+    std::unordered_map<podio::ObjectID, std::size_t, detail::ObjectIDHash> m_index {};
+  };
+
+  /**
+   * Reverse index from podio::ObjectID to a position in an IndexedVecMap that
+   * exploits that the objects are densely packed in their collections. Each
+   * collection gets a slot table that is directly addressed by the index of
+   * the ObjectID, turning lookups into plain array indexing.
+   *
+   * There are usually only very few collections per type, so they are found by
+   * a linear search, which is cheaper than hashing in that case. Lookups do
+   * not modify any state, so concurrent lookups are safe.
+   */
+  class DenseObjectIDIndex {
+  public:
+    void reserve(std::size_t) {}
+
+    void clear()
+    {
+      m_tables.clear();
+      m_lastTable = 0;
+    }
+
+    /// Index the position of an object. Existing entries are not overwritten
+    void insert(const podio::ObjectID& id, std::size_t pos)
+    {
+      auto& table = getOrCreateTable(id.collectionID);
+      const auto index = static_cast<std::size_t>(id.index);
+      if (index >= table.size()) {
+        table.resize(index + 1, EmptySlot);
+      }
+      if (table[index] == EmptySlot) {
+        table[index] = static_cast<int32_t>(pos);
+      }
+    }
+
+    std::optional<std::size_t> find(const podio::ObjectID& id) const
+    {
+      for (const auto& [collID, table] : m_tables) {
+        if (collID == id.collectionID) {
+          if (const auto index = static_cast<std::size_t>(id.index);
+              index < table.size() && table[index] != EmptySlot) {
+            return table[index];
+          }
+          return std::nullopt;
+        }
+      }
+      return std::nullopt;
+    }
+
+  private:
+    using CollIDT = decltype(podio::ObjectID::collectionID);
+    constexpr static int32_t EmptySlot = -1;
+
+    std::vector<int32_t>& getOrCreateTable(CollIDT collID)
+    {
+      // Objects are usually inserted collection by collection, so check the
+      // previously used table first
+      if (m_lastTable < m_tables.size() && m_tables[m_lastTable].first == collID) {
+        return m_tables[m_lastTable].second;
+      }
+      for (std::size_t i = 0; i < m_tables.size(); ++i) {
+        if (m_tables[i].first == collID) {
+          m_lastTable = i;
+          return m_tables[i].second;
+        }
+      }
+      m_lastTable = m_tables.size();
+      return m_tables.emplace_back(collID, std::vector<int32_t> {}).second;
+    }
+
+    std::vector<std::pair<CollIDT, std::vector<int32_t>>> m_tables {};
+    std::size_t m_lastTable {0};
+  };
+
+  /**
+   * A "map-like" container that keeps the insertion ordered vector<tuple<K, V>>
+   * storage of a VecMapT, but additionally maintains a hash index for the keys
+   * and a reverse index for the mapped (EDM4hep) objects via their
+   * podio::ObjectID. This makes the lookups in both directions (and hence also
+   * checked inserts) O(1) instead of O(N). The ReverseIndexT determines how
+   * the reverse index is implemented (see HashedObjectIDIndex and
+   * DenseObjectIDIndex).
+   *
+   * Mapped objects that are not (yet) part of a collection at the time of
+   * insertion cannot be put into the reverse index. If there are any of these,
+   * reverse lookups that miss the index fall back to a linear search.
+   *
+   * NOTE: This deliberately does not define a key_type, since it should still
+   * be treated as a "map-like" type that allows duplicate keys and that
+   * preserves the insertion order.
+   */
+  template<typename K, typename V, typename ReverseIndexT = HashedObjectIDIndex>
+  class IndexedVecMap {
+  public:
+    using value_type = std::tuple<K, V>;
+    using container_type = std::vector<value_type>;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+    iterator begin() { return m_data.begin(); }
+    iterator end() { return m_data.end(); }
+    const_iterator begin() const { return m_data.begin(); }
+    const_iterator end() const { return m_data.end(); }
+
+    std::size_t size() const { return m_data.size(); }
+    bool empty() const { return m_data.empty(); }
+
+    /// Make room for at least n elements. Grows the storage geometrically,
+    /// such that repeatedly reserving for a few more elements does not lead to
+    /// a reallocation every time
+    void reserve(std::size_t n)
+    {
+      detail::reserveGeometric(m_data, n);
+      m_keyIndex.reserve(n);
+      m_mappedIndex.reserve(n);
+    }
+
+    void clear()
+    {
+      m_data.clear();
+      m_keyIndex.clear();
+      m_mappedIndex.clear();
+      m_nUnindexed = 0;
+    }
+
+    /// Append a new element and put it into the indices. In case of duplicate
+    /// keys (or mapped objects) the indices keep pointing to the first one in
+    /// order to be consistent with a linear search
+    template<typename KeyT, typename MappedT>
+    value_type& emplace_back(KeyT&& key, MappedT&& mapped)
+    {
+      const auto pos = m_data.size();
+      auto& elem = m_data.emplace_back(std::forward<KeyT>(key), std::forward<MappedT>(mapped));
+      m_keyIndex.emplace(std::get<0>(elem), pos);
+
+      const auto objId = std::get<1>(elem).getObjectID();
+      if (objId.index < 0) {
+        m_nUnindexed++;
+      }
+      else {
+        m_mappedIndex.insert(objId, pos);
+      }
+
+      return elem;
+    }
+
+    /// Find the mapped object for a given key
+    std::optional<V> lookupTo(const K& key) const
+    {
+      if (const auto it = m_keyIndex.find(key); it != m_keyIndex.end()) {
+        return std::get<1>(m_data[it->second]);
+      }
+      return std::nullopt;
+    }
+
+    /// Find the key for a given mapped object
+    template<typename ToT>
+    std::optional<K> lookupFrom(const ToT& mapped) const
+    {
+      const auto objId = mapped.getObjectID();
+      if (objId.index >= 0) {
+        if (const auto pos = m_mappedIndex.find(objId)) {
+          if (const auto& elem = m_data[*pos]; std::get<1>(elem) == mapped) {
+            return std::get<0>(elem);
+          }
+        }
+        if (m_nUnindexed == 0) {
+          return std::nullopt;
+        }
+      }
+
+      if (const auto it = std::find_if(
+            m_data.begin(), m_data.end(), [&mapped](const auto& elem) { return std::get<1>(elem) == mapped; });
+          it != m_data.end()) {
+        return std::get<0>(*it);
+      }
+      return std::nullopt;
+    }
+
+  private:
+    container_type m_data {};
+    std::unordered_map<K, std::size_t> m_keyIndex {};
+    ReverseIndexT m_mappedIndex {};
+    std::size_t m_nUnindexed {0};
+  };
+
+  template<typename K, typename V>
+  using IndexedVecMapT = IndexedVecMap<K, V>;
+
+  /// An IndexedVecMap that addresses the mapped objects directly via their
+  /// (collectionID, index) instead of hashing their ObjectIDs
+  template<typename K, typename V>
+  using DenseVecMapT = IndexedVecMap<K, V, DenseObjectIDIndex>;
+
 } // namespace k4EDM4hep2LcioConv
 
 #endif // K4EDM4HEP2LCIOCONV_MAPPINGUTILS_H
@@ -0,0 +1,118 @@
+#ifndef K4EDM4HEP2LCIOCONV_TASKSCHEDULER_H
+#define K4EDM4HEP2LCIOCONV_TASKSCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace k4EDM4hep2LcioConv {
+
+  /**
+   * Simple work stealing task scheduler with a fixed number of worker threads.
+   *
+   * Each worker has its own queue of tasks. Tasks that are spawned from a
+   * worker are put into its own queue, from which it takes the most recently
+   * spawned one first. Tasks that are spawned from other threads are
+   * distributed round robin over the queues. Workers that run out of tasks
+   * steal the oldest tasks from the queues of the other workers.
+   *
+   * Tasks are spawned and waited for via a TaskGroup. Threads waiting for a
+   * TaskGroup run queued tasks in the meantime, such that tasks can spawn and
+   * wait for other tasks without blocking a worker.
+   */
+  class TaskScheduler {
+  public:
+    using Task = std::function<void()>;
+
+    /// Create a scheduler with nThreads worker threads (at least one)
+    explicit TaskScheduler(unsigned nThreads = std::thread::hardware_concurrency());
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    TaskScheduler(TaskScheduler&&) = delete;
+    TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+    /// The number of worker threads
+    unsigned nThreads() const { return m_threads.size(); }
+
+    /// The scheduler that runs the task from which this is called, or nullptr
+    /// if it is not called from within a task
+    static TaskScheduler* current();
+
+    /**
+     * A set of tasks that can be waited for together. Exceptions thrown by
+     * the tasks are caught and the first one is rethrown by wait.
+     */
+    class TaskGroup {
+    public:
+      explicit TaskGroup(TaskScheduler& scheduler) : m_scheduler(scheduler) {}
+      /// Waits for all tasks that are still running
+      ~TaskGroup();
+
+      TaskGroup(const TaskGroup&) = delete;
+      TaskGroup& operator=(const TaskGroup&) = delete;
+
+      /// Run the task asynchronously as part of this group
+      void run(Task task);
+
+      /// Wait until all tasks of this group are done, running queued tasks in
+      /// the meantime and sleeping if there are none. Rethrows the first
+      /// exception that has been thrown by one of the tasks
+      void wait();
+
+    private:
+      TaskScheduler& m_scheduler;
+      std::atomic<std::size_t> m_nPending {0};
+      std::mutex m_errorMutex {};
+      std::exception_ptr m_error {};
+    };
+
+  private:
+    struct WorkerQueue {
+      std::mutex mutex {};
+      std::deque<Task> tasks {};
+    };
+
+    /// Put a task into the queue of the calling worker or into one of the
+    /// queues if called from outside the workers
+    void spawn(Task task);
+
+    /// Run one task, preferably from the queue with the passed index. Returns
+    /// false if there was no task to run
+    bool runOneTask(std::size_t preferredQueue);
+
+    /// Take the newest task from the queue with the passed index
+    bool popTask(std::size_t queue, Task& task);
+
+    /// Take the oldest task from any queue other than the passed one
+    bool stealTask(std::size_t thief, Task& task);
+
+    void workerLoop(std::size_t index);
+
+    /// Wake up all sleeping workers and threads waiting for a TaskGroup
+    void notifyAll();
+
+    /// Get the index of the queue of the calling thread, or the number of
+    /// queues if it is not a worker of this scheduler
+    std::size_t currentQueue() const;
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues {};
+    std::vector<std::thread> m_threads {};
+    std::atomic<std::size_t> m_nQueued {0};
+    std::atomic<std::size_t> m_nextQueue {0};
+    std::mutex m_sleepMutex {};
+    std::condition_variable m_wakeUp {};
+    bool m_stop {false};
+  };
+
+} // namespace k4EDM4hep2LcioConv
+
+#endif // K4EDM4HEP2LCIOCONV_TASKSCHEDULER_H
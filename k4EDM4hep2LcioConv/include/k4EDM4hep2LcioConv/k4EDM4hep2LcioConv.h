@@ -1,6 +1,9 @@
 #ifndef K4EDM4HEP2LCIOCONV_H
 #define K4EDM4HEP2LCIOCONV_H
 
+#include "k4EDM4hep2LcioConv/CapacityPlanner.h"
+#include "k4EDM4hep2LcioConv/EventConversion.h"
+#include "k4EDM4hep2LcioConv/FieldDescriptors.h"
 #include "k4EDM4hep2LcioConv/MappingUtils.h"
 
 // EDM4hep
@@ -73,7 +76,12 @@ namespace edm4hep {
 #include <UTIL/CellIDEncoder.h>
 #include <lcio.h>
 
+#include <iostream>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
 
 // Preprocessor symbol that can be used in downstream code to switch on the
 // namespace for the conversion
@@ -82,25 +90,54 @@ namespace edm4hep {
 namespace EDM4hep2LCIOConv {
 
   template<typename T1, typename T2>
-  using ObjectMapT = k4EDM4hep2LcioConv::VecMapT<T1, T2>;
+  using ObjectMapT = k4EDM4hep2LcioConv::IndexedVecMapT<T1, T2>;
 
   template<typename T1, typename T2>
   using vec_pair [[deprecated("Use a more descriptive alias")]] = ObjectMapT<T1, T2>;
 
-  struct CollectionsPairVectors {
-    ObjectMapT<lcio::TrackImpl*, edm4hep::Track> tracks {};
-    ObjectMapT<lcio::TrackerHitImpl*, edm4hep::TrackerHit> trackerHits {};
-    ObjectMapT<lcio::SimTrackerHitImpl*, edm4hep::SimTrackerHit> simTrackerHits {};
-    ObjectMapT<lcio::CalorimeterHitImpl*, edm4hep::CalorimeterHit> caloHits {};
-    ObjectMapT<lcio::RawCalorimeterHitImpl*, edm4hep::RawCalorimeterHit> rawCaloHits {};
-    ObjectMapT<lcio::SimCalorimeterHitImpl*, edm4hep::SimCalorimeterHit> simCaloHits {};
-    ObjectMapT<lcio::TPCHitImpl*, edm4hep::RawTimeSeries> tpcHits {};
-    ObjectMapT<lcio::ClusterImpl*, edm4hep::Cluster> clusters {};
-    ObjectMapT<lcio::VertexImpl*, edm4hep::Vertex> vertices {};
-    ObjectMapT<lcio::ReconstructedParticleImpl*, edm4hep::ReconstructedParticle> recoParticles {};
-    ObjectMapT<lcio::MCParticleImpl*, edm4hep::MCParticle> mcParticles {};
+  /// Object mapping that addresses the EDM4hep objects directly via their
+  /// (collectionID, index) for reverse lookups. Can be used with
+  /// CollectionsPairVectorsT to select the mapping mode for all types at once
+  template<typename T1, typename T2>
+  using DenseObjectMapT = k4EDM4hep2LcioConv::DenseVecMapT<T1, T2>;
+
+  template<template<typename...> typename MapT>
+  struct CollectionsPairVectorsT {
+    MapT<lcio::TrackImpl*, edm4hep::Track> tracks {};
+    MapT<lcio::TrackerHitImpl*, edm4hep::TrackerHit> trackerHits {};
+    MapT<lcio::SimTrackerHitImpl*, edm4hep::SimTrackerHit> simTrackerHits {};
+    MapT<lcio::CalorimeterHitImpl*, edm4hep::CalorimeterHit> caloHits {};
+    MapT<lcio::RawCalorimeterHitImpl*, edm4hep::RawCalorimeterHit> rawCaloHits {};
+    MapT<lcio::SimCalorimeterHitImpl*, edm4hep::SimCalorimeterHit> simCaloHits {};
+    MapT<lcio::TPCHitImpl*, edm4hep::RawTimeSeries> tpcHits {};
+    MapT<lcio::ClusterImpl*, edm4hep::Cluster> clusters {};
+    MapT<lcio::VertexImpl*, edm4hep::Vertex> vertices {};
+    MapT<lcio::ReconstructedParticleImpl*, edm4hep::ReconstructedParticle> recoParticles {};
+    MapT<lcio::MCParticleImpl*, edm4hep::MCParticle> mcParticles {};
+
+    /// Call func(name, map) for all the contained mappings
+    template<typename FuncT>
+    void forEachMap(FuncT&& func)
+    {
+      func("tracks", tracks);
+      func("trackerHits", trackerHits);
+      func("simTrackerHits", simTrackerHits);
+      func("caloHits", caloHits);
+      func("rawCaloHits", rawCaloHits);
+      func("simCaloHits", simCaloHits);
+      func("tpcHits", tpcHits);
+      func("clusters", clusters);
+      func("vertices", vertices);
+      func("recoParticles", recoParticles);
+      func("mcParticles", mcParticles);
+    }
   };
 
+  // A struct rather than an alias, such that it can still be forward declared
+  struct CollectionsPairVectors : CollectionsPairVectorsT<ObjectMapT> {};
+
+  using DenseCollectionsPairVectors = CollectionsPairVectorsT<DenseObjectMapT>;
+
   template<typename TrackMapT, typename TrackerHitMapT>
   lcio::LCCollectionVec* convTracks(
     const edm4hep::TrackCollection* const tracks_coll,
@@ -163,6 +200,10 @@ namespace EDM4hep2LCIOConv {
     const VertexMapT& vertex_vec,
     const ClusterMapT& clusters_vec);
 
+  /// Convert a single ParticleID. The caller takes ownership of the returned
+  /// object (usually by attaching it to a Cluster or ReconstructedParticle)
+  lcio::ParticleIDImpl* convParticleID(const edm4hep::ParticleID& edm_pid);
+
   template<typename MCPartMapT>
   lcio::LCCollectionVec* convMCParticles(
     const edm4hep::MCParticleCollection* const mcparticle_coll,
@@ -170,6 +211,26 @@ namespace EDM4hep2LCIOConv {
 
   void convEventHeader(const edm4hep::EventHeaderCollection* const header_coll, lcio::LCEventImpl* const lcio_event);
 
+  /// Create an LCIO subset collection from an EDM4hep subset collection. The
+  /// elements point to the LCIO objects that have been converted from the
+  /// original EDM4hep objects, i.e. they are not copied again. Objects for
+  /// which no converted LCIO object can be found in elemMap are skipped.
+  template<typename CollT, typename ObjectMapT>
+  lcio::LCCollectionVec*
+  convSubsetCollection(const CollT* const subset_coll, const ObjectMapT& elemMap, const std::string& lcioTypeName);
+
+  /// Link the converted ReconstructedParticles to their start vertex. Vertices
+  /// and ReconstructedParticles point to each other, so this link can only be
+  /// set once both have been converted
+  template<typename RecoPartMapT, typename VertexMapT>
+  void linkStartVertices(RecoPartMapT& recoparticles_vec, const VertexMapT& vertex_vec);
+
+  /// Attach the CaloHitContributions to the converted SimCalorimeterHits. This
+  /// should happen once all MCParticles have been converted, since the
+  /// contributions point to them
+  template<typename SimCaloHitMapT, typename MCPartMapT>
+  void convCaloHitContributions(SimCaloHitMapT& sim_calo_hits_vec, const MCPartMapT& mcparticles_vec);
+
   template<typename ObjectMappingT>
   void FillMissingCollections(ObjectMappingT& update_pairs);
 
@@ -180,15 +241,279 @@ namespace EDM4hep2LCIOConv {
 
   bool collectionExist(const std::string& collection_name, const lcio::LCEventImpl* lcio_event);
 
+  /// Attach the CellIDEncoding to a collection of hits and set the flag bit
+  /// that marks the use of cellID1. This is what constructing a
+  /// lcio::CellIDEncoder does, without the parsing of the encoding string.
+  /// Nothing is done for an empty cellIDEncoding
+  void setCellIDEncoding(lcio::LCCollectionVec* coll, const std::string& cellIDEncoding, int flagBit);
+
+  /// Function converting one EDM4hep collection. Returns the converted LCIO
+  /// collection, or a nullptr for collections that do not result in an LCIO
+  /// collection of their own (e.g. the EventHeader)
+  template<typename ObjectMappingT>
+  using CollectionConverterT = lcio::LCCollectionVec* (*)(const podio::CollectionBase* coll,
+                                                          const std::string& cellIDStr,
+                                                          ObjectMappingT& objectMappings,
+                                                          lcio::LCEventImpl* lcioEvent);
+
+  /**
+   * Get the function that converts a collection with the passed value type
+   * name (as returned by getValueTypeName), or a nullptr if there is no known
+   * conversion for it.
+   */
+  template<typename ObjectMappingT>
+  CollectionConverterT<ObjectMappingT> getCollectionConverter(std::string_view valueTypeName);
+
+  /// Function filling an LCIO subset collection from an EDM4hep subset
+  /// collection
+  template<typename ObjectMappingT>
+  using SubsetConverterT =
+    lcio::LCCollectionVec* (*)(const podio::CollectionBase* coll, const ObjectMappingT& objectMappings);
+
+  /**
+   * Get the function that fills a subset collection with the passed value
+   * type name, or a nullptr if there is no known conversion for it.
+   */
+  template<typename ObjectMappingT>
+  SubsetConverterT<ObjectMappingT> getSubsetConverter(std::string_view valueTypeName);
+
+  /**
+   * Get the conversion rank (see EdmTypeTraits) of a collection with the
+   * passed value type name. Converting collections in ascending order of this
+   * rank makes it possible to set (almost) all relations during the conversion
+   * already. Unknown types get a rank of 0.
+   */
+  int getConversionRank(std::string_view valueTypeName);
+
+  /**
+   * Compile time registry of the EDM4hep collection types that are known to
+   * the conversion. Each specialization ties an EDM4hep collection type to the
+   * function converting it, using the object mappings that are necessary for
+   * that. getCollectionConverter is generated from the types listed in
+   * KnownEdmCollectionTypes.
+   *
+   * The conversionRank is the length of the longest chain of types that have
+   * to be converted before this type, such that all its relations can be set
+   * during its conversion. The only exception to that are Vertices and
+   * ReconstructedParticles, which point to each other.
+   *
+   * When adding a new type a specialization has to be added here, the type
+   * has to be added to KnownEdmCollectionTypes (and a new member to
+   * CollectionsPairVectorsT if necessary).
+   */
+  template<typename CollT>
+  struct EdmTypeTraits {
+    static constexpr bool convertible = false;
+  };
+
+#define K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(COLL, RANK, CONVERT)          \
+  template<>                                                            \
+  struct EdmTypeTraits<COLL> {                                          \
+    static constexpr bool convertible = true;                           \
+    static constexpr int conversionRank = RANK;                         \
+    template<typename ObjectMappingT>                                   \
+    static lcio::LCCollectionVec* convert(                              \
+      [[maybe_unused]] const COLL* coll,                                \
+      [[maybe_unused]] const std::string& cellIDStr,                    \
+      [[maybe_unused]] ObjectMappingT& maps,                            \
+      [[maybe_unused]] lcio::LCEventImpl* lcioEvent)                    \
+    {                                                                   \
+      return CONVERT;                                                   \
+    }                                                                   \
+  };
+
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(edm4hep::TrackCollection, 1, convTracks(coll, maps.tracks, maps.trackerHits))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(
+    edm4hep::TrackerHitCollection,
+    0,
+    convTrackerHits(coll, cellIDStr, maps.trackerHits))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(
+    edm4hep::SimTrackerHitCollection,
+    1,
+    convSimTrackerHits(coll, cellIDStr, maps.simTrackerHits, maps.mcParticles))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(
+    edm4hep::CalorimeterHitCollection,
+    0,
+    convCalorimeterHits(coll, cellIDStr, maps.caloHits))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(
+    edm4hep::RawCalorimeterHitCollection,
+    0,
+    convRawCalorimeterHits(coll, maps.rawCaloHits))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(
+    edm4hep::SimCalorimeterHitCollection,
+    1,
+    convSimCalorimeterHits(coll, cellIDStr, maps.simCaloHits, maps.mcParticles))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(edm4hep::RawTimeSeriesCollection, 0, convTPCHits(coll, maps.tpcHits))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(edm4hep::ClusterCollection, 1, convClusters(coll, maps.clusters, maps.caloHits))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(
+    edm4hep::VertexCollection,
+    3,
+    convVertices(coll, maps.vertices, maps.recoParticles))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(edm4hep::MCParticleCollection, 0, convMCParticles(coll, maps.mcParticles))
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(
+    edm4hep::ReconstructedParticleCollection,
+    2,
+    convReconstructedParticles(coll, maps.recoParticles, maps.tracks, maps.vertices, maps.clusters))
+  // The EventHeader is not converted into a collection of its own
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(edm4hep::EventHeaderCollection, 0, (convEventHeader(coll, lcioEvent), nullptr))
+  // CaloHitContributions are "converted" by convCaloHitContributions at the
+  // end and ParticleIDs as part of the Clusters and ReconstructedParticles
+  // they are attached to
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(edm4hep::CaloHitContributionCollection, 0, nullptr)
+  K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS(edm4hep::ParticleIDCollection, 0, nullptr)
+
+#undef K4EDM4HEP2LCIOCONV_EDM_TYPE_TRAITS
+
+  /**
+   * Compile time registry of the EDM4hep collection types for which subset
+   * collections can be converted into LCIO subset collections. Each
+   * specialization defines the LCIO collection type and which of the object
+   * mappings holds the converted objects. getSubsetConverter is generated from
+   * these.
+   */
+  template<typename CollT>
+  struct EdmSubsetTraits {
+    static constexpr bool subsettable = false;
+  };
+
+#define K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(COLL, LCIO_TYPE, MAP)          \
+  template<>                                                               \
+  struct EdmSubsetTraits<COLL> {                                           \
+    static constexpr bool subsettable = true;                              \
+    static std::string lcioTypeName() { return LCIO_TYPE; }                \
+    template<typename ObjectMappingT>                                      \
+    static const auto& map(const ObjectMappingT& maps)                     \
+    {                                                                      \
+      return maps.MAP;                                                     \
+    }                                                                      \
+  };
+
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::TrackCollection, lcio::LCIO::TRACK, tracks)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::TrackerHitCollection, lcio::LCIO::TRACKERHIT, trackerHits)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::SimTrackerHitCollection, lcio::LCIO::SIMTRACKERHIT, simTrackerHits)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::CalorimeterHitCollection, lcio::LCIO::CALORIMETERHIT, caloHits)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::RawCalorimeterHitCollection, lcio::LCIO::RAWCALORIMETERHIT, rawCaloHits)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::SimCalorimeterHitCollection, lcio::LCIO::SIMCALORIMETERHIT, simCaloHits)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::RawTimeSeriesCollection, lcio::LCIO::TPCHIT, tpcHits)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::ClusterCollection, lcio::LCIO::CLUSTER, clusters)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::VertexCollection, lcio::LCIO::VERTEX, vertices)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(edm4hep::MCParticleCollection, lcio::LCIO::MCPARTICLE, mcParticles)
+  K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS(
+    edm4hep::ReconstructedParticleCollection,
+    lcio::LCIO::RECONSTRUCTEDPARTICLE,
+    recoParticles)
+
+#undef K4EDM4HEP2LCIOCONV_EDM_SUBSET_TRAITS
+
+  /// All EDM4hep collection types for which there is an EdmTypeTraits
+  /// specialization
+  using KnownEdmCollectionTypes = std::tuple<
+    edm4hep::TrackCollection,
+    edm4hep::TrackerHitCollection,
+    edm4hep::SimTrackerHitCollection,
+    edm4hep::CalorimeterHitCollection,
+    edm4hep::RawCalorimeterHitCollection,
+    edm4hep::SimCalorimeterHitCollection,
+    edm4hep::RawTimeSeriesCollection,
+    edm4hep::ClusterCollection,
+    edm4hep::VertexCollection,
+    edm4hep::MCParticleCollection,
+    edm4hep::ReconstructedParticleCollection,
+    edm4hep::EventHeaderCollection,
+    edm4hep::CaloHitContributionCollection,
+    edm4hep::ParticleIDCollection>;
+
+  // convEvent is declared in EventConversion.h
+
   /**
-   * Convert an edm4hep event to an LCEvent
+   * Stateful converter for complete edm4hep events.
+   *
+   * Converting an event in the same way as convEvent, but keeping the object
+   * mappings alive between events. They are cleared after each event, but
+   * without releasing their memory. Additionally, the sizes of the mappings
+   * are recorded to reserve enough space for them up front in the following
+   * events. The conversion function and the CellIDEncoding for each
+   * collection are looked up once per collection name and then cached. The
+   * CellIDEncodings are taken from the metadata Frame that is passed via the
+   * constructor or setMetadata. It has to be set again (e.g. for a new file)
+   * to invalidate the cached ones.
+   *
+   * NOTE: Not thread safe. Use one EventConverter per thread.
    */
-  std::unique_ptr<lcio::LCEventImpl> convEvent(
-    const podio::Frame& edmEvent,
-    const podio::Frame& metadata = podio::Frame {});
+  class EventConverter {
+  public:
+    EventConverter() = default;
+
+    /// Create a converter that takes the CellIDEncodings from the metadata
+    /// Frame, which has to outlive all conversions (see setMetadata)
+    explicit EventConverter(const podio::Frame& metadata);
+
+    /**
+     * Set the metadata Frame from which the CellIDEncodings are taken and
+     * invalidate all cached ones, such that they are looked up again. The
+     * Frame has to stay alive as long as events are converted with it.
+     */
+    void setMetadata(const podio::Frame& metadata);
+
+    /// The metadata Frame that is currently used (nullptr if there is none)
+    const podio::Frame* getMetadata() const { return m_metadata; }
+
+    /**
+     * Convert an edm4hep event to an LCEvent
+     */
+    std::unique_ptr<lcio::LCEventImpl> convert(const podio::Frame& edmEvent);
+
+    /// Get the statistics of the capacity planning for the object mappings
+    const k4EDM4hep2LcioConv::CapacityPlanner::Stats& capacityStats() const { return m_capacityPlanner.stats(); }
+
+  private:
+    /// How to convert a collection with a given name. Computed when a name is
+    /// encountered for the first time and only recomputed if the type of the
+    /// collection changes
+    struct DispatchEntry {
+      std::string valueTypeName {};
+      CollectionConverterT<CollectionsPairVectors> convert {nullptr};
+      int conversionRank {0};
+      SubsetConverterT<CollectionsPairVectors> fillSubset {nullptr};
+      std::string cellIDEncoding {};
+      /// Whether cellIDEncoding has been taken from the current metadata
+      bool hasCellIDEncoding {false};
+    };
+
+    /// Clear all internal state for the next event
+    void reset();
+
+    /// Get the (possibly cached) dispatch entry for a collection. Reports
+    /// unsupported collection types when they are first encountered
+    const DispatchEntry&
+    getDispatchEntry(const std::string& name, const podio::CollectionBase* coll);
+
+    k4EDM4hep2LcioConv::CapacityPlanner m_capacityPlanner {};
+    std::unordered_map<std::string, DispatchEntry> m_dispatchPlan {};
+    /// The metadata Frame from which the CellIDEncodings are taken (if any)
+    const podio::Frame* m_metadata {nullptr};
+    CollectionsPairVectors m_objectMappings {};
+  };
 
 } // namespace EDM4hep2LCIOConv
 
 #include "k4EDM4hep2LcioConv/k4EDM4hep2LcioConv.ipp"
 
+namespace EDM4hep2LCIOConv {
+  // The instantiations for the default CollectionsPairVectors are compiled into
+  // the library (see k4EDM4hep2LcioConv.cpp) and do not have to be redone in
+  // every translation unit that includes this header
+  extern template void FillMissingCollections(CollectionsPairVectors&);
+  extern template void FillMissingCollections(CollectionsPairVectors&, const CollectionsPairVectors&);
+  extern template CollectionConverterT<CollectionsPairVectors>
+  getCollectionConverter<CollectionsPairVectors>(std::string_view);
+  extern template SubsetConverterT<CollectionsPairVectors> getSubsetConverter<CollectionsPairVectors>(std::string_view);
+  extern template void linkStartVertices(
+    decltype(CollectionsPairVectors::recoParticles)&,
+    const decltype(CollectionsPairVectors::vertices)&);
+  extern template void convCaloHitContributions(
+    decltype(CollectionsPairVectors::simCaloHits)&,
+    const decltype(CollectionsPairVectors::mcParticles)&);
+} // namespace EDM4hep2LCIOConv
+
 #endif
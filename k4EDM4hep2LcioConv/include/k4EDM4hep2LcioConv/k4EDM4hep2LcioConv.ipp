@@ -14,6 +14,8 @@ namespace EDM4hep2LCIOConv {
     const TrackerHitMapT& trackerhits_vec)
   {
     auto* tracks = new lcio::LCCollectionVec(lcio::LCIO::TRACK);
+    tracks->reserve(tracks_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(tracks_vec, tracks_coll->size());
 
     // Loop over EDM4hep tracks converting them to lcio tracks.
     for (const auto& edm_tr : (*tracks_coll)) {
@@ -123,28 +125,20 @@ namespace EDM4hep2LCIOConv {
     TrackerHitMapT& trackerhits_vec)
   {
     auto* trackerhits = new lcio::LCCollectionVec(lcio::LCIO::TRACKERHIT);
+    trackerhits->reserve(trackerhits_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(trackerhits_vec, trackerhits_coll->size());
 
-    if (cellIDstr != "") {
-      lcio::CellIDEncoder<lcio::SimCalorimeterHitImpl> idEnc(cellIDstr, trackerhits);
-    }
+    setCellIDEncoding(trackerhits, cellIDstr, lcio::LCIO::CHBIT_ID1);
 
     // Loop over EDM4hep trackerhits converting them to lcio trackerhits
     for (const auto& edm_trh : (*trackerhits_coll)) {
       if (edm_trh.isAvailable()) {
         auto* lcio_trh = new lcio::TrackerHitImpl();
 
-        uint64_t combined_value = edm_trh.getCellID();
-        uint32_t* combined_value_ptr = reinterpret_cast<uint32_t*>(&combined_value);
-        lcio_trh->setCellID0(combined_value_ptr[0]);
-        lcio_trh->setCellID1(combined_value_ptr[1]);
-        lcio_trh->setType(edm_trh.getType());
+        k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::TrackerHit>::toLcio(edm_trh, lcio_trh);
         std::array<double, 3> positions {edm_trh.getPosition()[0], edm_trh.getPosition()[1], edm_trh.getPosition()[2]};
         lcio_trh->setPosition(positions.data());
         lcio_trh->setCovMatrix(edm_trh.getCovMatrix().data());
-        lcio_trh->setEDep(edm_trh.getEDep());
-        lcio_trh->setEDepError(edm_trh.getEDepError());
-        lcio_trh->setTime(edm_trh.getTime());
-        lcio_trh->setQuality(edm_trh.getQuality());
         std::bitset<sizeof(uint32_t)> type_bits = edm_trh.getQuality();
         for (int j = 0; j < sizeof(uint32_t); j++) {
           lcio_trh->setQualityBit(j, (type_bits[j] == 0) ? 0 : 1);
@@ -172,28 +166,21 @@ namespace EDM4hep2LCIOConv {
     const MCParticleMapT& mcparticles_vec)
   {
     auto* simtrackerhits = new lcio::LCCollectionVec(lcio::LCIO::SIMTRACKERHIT);
+    simtrackerhits->reserve(simtrackerhits_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(simtrackerhits_vec, simtrackerhits_coll->size());
 
-    if (cellIDstr != "") {
-      lcio::CellIDEncoder<lcio::SimTrackerHitImpl> idEnc(cellIDstr, simtrackerhits);
-    }
+    setCellIDEncoding(simtrackerhits, cellIDstr, lcio::LCIO::THBIT_ID1);
 
     // Loop over EDM4hep simtrackerhits converting them to LCIO simtrackerhits
     for (const auto& edm_strh : (*simtrackerhits_coll)) {
       if (edm_strh.isAvailable()) {
         auto* lcio_strh = new lcio::SimTrackerHitImpl();
 
-        uint64_t combined_value = edm_strh.getCellID();
-        uint32_t* combined_value_ptr = reinterpret_cast<uint32_t*>(&combined_value);
-        lcio_strh->setCellID0(combined_value_ptr[0]);
-        lcio_strh->setCellID1(combined_value_ptr[1]);
+        k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::SimTrackerHit>::toLcio(edm_strh, lcio_strh);
         std::array<double, 3> positions {
           edm_strh.getPosition()[0], edm_strh.getPosition()[1], edm_strh.getPosition()[2]};
         lcio_strh->setPosition(positions.data());
-        lcio_strh->setEDep(edm_strh.getEDep());
-        lcio_strh->setTime(edm_strh.getTime());
         lcio_strh->setMomentum(edm_strh.getMomentum()[0], edm_strh.getMomentum()[1], edm_strh.getMomentum()[2]);
-        lcio_strh->setPathLength(edm_strh.getPathLength());
-        lcio_strh->setQuality(edm_strh.getQuality());
         // lcio_strh->setQualityBit( int bit , bool val=true ) ;
         lcio_strh->setOverlay(edm_strh.isOverlay());
         lcio_strh->setProducedBySecondary(edm_strh.isProducedBySecondary());
@@ -231,26 +218,19 @@ namespace EDM4hep2LCIOConv {
     CaloHitMapT& calo_hits_vec)
   {
     auto* calohits = new lcio::LCCollectionVec(lcio::LCIO::CALORIMETERHIT);
+    calohits->reserve(calohit_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(calo_hits_vec, calohit_coll->size());
 
-    if (cellIDstr != "") {
-      lcio::CellIDEncoder<lcio::SimCalorimeterHitImpl> idEnc(cellIDstr, calohits);
-    }
+    setCellIDEncoding(calohits, cellIDstr, lcio::LCIO::CHBIT_ID1);
 
     for (const auto& edm_calohit : (*calohit_coll)) {
       if (edm_calohit.isAvailable()) {
         auto* lcio_calohit = new lcio::CalorimeterHitImpl();
 
-        uint64_t combined_value = edm_calohit.getCellID();
-        uint32_t* combined_value_ptr = reinterpret_cast<uint32_t*>(&combined_value);
-        lcio_calohit->setCellID0(combined_value_ptr[0]);
-        lcio_calohit->setCellID1(combined_value_ptr[1]);
-        lcio_calohit->setEnergy(edm_calohit.getEnergy());
-        lcio_calohit->setEnergyError(edm_calohit.getEnergyError());
-        lcio_calohit->setTime(edm_calohit.getTime());
+        k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::CalorimeterHit>::toLcio(edm_calohit, lcio_calohit);
         std::array<float, 3> positions {
           edm_calohit.getPosition()[0], edm_calohit.getPosition()[1], edm_calohit.getPosition()[2]};
         lcio_calohit->setPosition(positions.data());
-        lcio_calohit->setType(edm_calohit.getType());
 
         // TODO
         // lcio_calohit->setRawHit(EVENT::LCObject* rawHit );
@@ -275,17 +255,14 @@ namespace EDM4hep2LCIOConv {
     RawCaloHitMapT& raw_calo_hits_vec)
   {
     auto* rawcalohits = new lcio::LCCollectionVec(lcio::LCIO::RAWCALORIMETERHIT);
+    rawcalohits->reserve(rawcalohit_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(raw_calo_hits_vec, rawcalohit_coll->size());
 
     for (const auto& edm_raw_calohit : (*rawcalohit_coll)) {
       if (edm_raw_calohit.isAvailable()) {
         auto* lcio_rawcalohit = new lcio::RawCalorimeterHitImpl();
 
-        uint64_t combined_value = edm_raw_calohit.getCellID();
-        uint32_t* combined_value_ptr = reinterpret_cast<uint32_t*>(&combined_value);
-        lcio_rawcalohit->setCellID0(combined_value_ptr[0]);
-        lcio_rawcalohit->setCellID1(combined_value_ptr[1]);
-        lcio_rawcalohit->setAmplitude(edm_raw_calohit.getAmplitude());
-        lcio_rawcalohit->setTimeStamp(edm_raw_calohit.getTimeStamp());
+        k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::RawCalorimeterHit>::toLcio(edm_raw_calohit, lcio_rawcalohit);
 
         // Save Raw Calorimeter Hits LCIO and EDM4hep collections
         k4EDM4hep2LcioConv::detail::mapInsert(lcio_rawcalohit, edm_raw_calohit, raw_calo_hits_vec);
@@ -309,20 +286,16 @@ namespace EDM4hep2LCIOConv {
     const MCParticleMapT& mcparticles)
   {
     auto* simcalohits = new lcio::LCCollectionVec(lcio::LCIO::SIMCALORIMETERHIT);
+    simcalohits->reserve(simcalohit_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(sim_calo_hits_vec, simcalohit_coll->size());
 
-    if (cellIDstr != "") {
-      lcio::CellIDEncoder<lcio::SimCalorimeterHitImpl> idEnc(cellIDstr, simcalohits);
-    }
+    setCellIDEncoding(simcalohits, cellIDstr, lcio::LCIO::CHBIT_ID1);
 
     for (const auto& edm_sim_calohit : (*simcalohit_coll)) {
       if (edm_sim_calohit.isAvailable()) {
         auto* lcio_simcalohit = new lcio::SimCalorimeterHitImpl();
 
-        uint64_t combined_value = edm_sim_calohit.getCellID();
-        uint32_t* combined_value_ptr = reinterpret_cast<uint32_t*>(&combined_value);
-        lcio_simcalohit->setCellID0(combined_value_ptr[0]);
-        lcio_simcalohit->setCellID1(combined_value_ptr[1]);
-        lcio_simcalohit->setEnergy(edm_sim_calohit.getEnergy());
+        k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::SimCalorimeterHit>::toLcio(edm_sim_calohit, lcio_simcalohit);
         std::array<float, 3> positions {
           edm_sim_calohit.getPosition()[0], edm_sim_calohit.getPosition()[1], edm_sim_calohit.getPosition()[2]};
         lcio_simcalohit->setPosition(positions.data());
@@ -350,6 +323,8 @@ namespace EDM4hep2LCIOConv {
     TPCHitMapT& tpc_hits_vec)
   {
     auto* tpchits = new lcio::LCCollectionVec(lcio::LCIO::TPCHIT);
+    tpchits->reserve(tpchit_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(tpc_hits_vec, tpchit_coll->size());
 
     for (const auto& edm_tpchit : (*tpchit_coll)) {
       if (edm_tpchit.isAvailable()) {
@@ -397,6 +372,8 @@ namespace EDM4hep2LCIOConv {
     const CaloHitMapT& calohits_vec)
   {
     auto* clusters = new lcio::LCCollectionVec(lcio::LCIO::CLUSTER);
+    clusters->reserve(cluster_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(cluster_vec, cluster_coll->size());
 
     // Loop over EDM4hep clusters converting them to lcio clusters
     for (const auto& edm_cluster : (*cluster_coll)) {
@@ -427,19 +404,10 @@ namespace EDM4hep2LCIOConv {
         }
         lcio_cluster->setShape(shape_vec);
 
-        // Convert ParticleIDs associated to the recoparticle
+        // Convert ParticleIDs associated to the cluster
         for (const auto& edm_pid : edm_cluster.getParticleIDs()) {
           if (edm_pid.isAvailable()) {
-            auto* lcio_pid = new lcio::ParticleIDImpl;
-
-            lcio_pid->setType(edm_pid.getType());
-            lcio_pid->setPDG(edm_pid.getPDG());
-            lcio_pid->setLikelihood(edm_pid.getLikelihood());
-            lcio_pid->setAlgorithmType(edm_pid.getAlgorithmType());
-            for (const auto& param : edm_pid.getParameters()) {
-              lcio_pid->addParameter(param);
-            }
-
+            auto* lcio_pid = convParticleID(edm_pid);
             lcio_cluster->addParticleID(lcio_pid);
           }
         }
@@ -478,6 +446,8 @@ namespace EDM4hep2LCIOConv {
     const RecoPartMapT& recoparticles_vec)
   {
     auto* vertices = new lcio::LCCollectionVec(lcio::LCIO::VERTEX);
+    vertices->reserve(vertex_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(vertex_vec, vertex_coll->size());
 
     // Loop over EDM4hep vertex converting them to lcio vertex
     for (const auto& edm_vertex : (*vertex_coll)) {
@@ -528,6 +498,8 @@ namespace EDM4hep2LCIOConv {
     const ClusterMapT& clusters_vec)
   {
     auto* recops = new lcio::LCCollectionVec(lcio::LCIO::RECONSTRUCTEDPARTICLE);
+    recops->reserve(recos_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(recoparticles_vec, recos_coll->size());
 
     for (const auto& edm_rp : (*recos_coll)) {
       auto* lcio_recp = new lcio::ReconstructedParticleImpl;
@@ -543,38 +515,15 @@ namespace EDM4hep2LCIOConv {
         lcio_recp->setReferencePoint(rp);
         lcio_recp->setGoodnessOfPID(edm_rp.getGoodnessOfPID());
 
-        // Convert ParticleIDs associated to the recoparticle
+        // Convert ParticleIDs associated to the recoparticle. The one that has
+        // been used is identified by identity, since it has to be one of them
+        const auto edm_pid_used = edm_rp.getParticleIDUsed();
         for (const auto& edm_pid : edm_rp.getParticleIDs()) {
           if (edm_pid.isAvailable()) {
-            auto* lcio_pid = new lcio::ParticleIDImpl;
-
-            lcio_pid->setType(edm_pid.getType());
-            lcio_pid->setPDG(edm_pid.getPDG());
-            lcio_pid->setLikelihood(edm_pid.getLikelihood());
-            lcio_pid->setAlgorithmType(edm_pid.getAlgorithmType());
-            for (const auto& param : edm_pid.getParameters()) {
-              lcio_pid->addParameter(param);
-            }
-
+            auto* lcio_pid = convParticleID(edm_pid);
             lcio_recp->addParticleID(lcio_pid);
-          }
-        }
-
-        // Link sinlge associated Particle
-        auto edm_pid_used = edm_rp.getParticleIDUsed();
-        if (edm_pid_used.isAvailable()) {
-          for (const auto& lcio_pid : lcio_recp->getParticleIDs()) {
-            bool is_same = true;
-            is_same = is_same && (lcio_pid->getType() == edm_pid_used.getType());
-            is_same = is_same && (lcio_pid->getPDG() == edm_pid_used.getPDG());
-            is_same = is_same && (lcio_pid->getLikelihood() == edm_pid_used.getLikelihood());
-            is_same = is_same && (lcio_pid->getAlgorithmType() == edm_pid_used.getAlgorithmType());
-            for (int i = 0; i < edm_pid_used.parameters_size(); ++i) {
-              is_same = is_same && (edm_pid_used.getParameters(i) == lcio_pid->getParameters()[i]);
-            }
-            if (is_same) {
+            if (edm_pid == edm_pid_used) {
               lcio_recp->setParticleIDUsed(lcio_pid);
-              break;
             }
           }
         }
@@ -646,6 +595,8 @@ namespace EDM4hep2LCIOConv {
     MCPartMapT& mc_particles_vec)
   {
     auto* mcparticles = new lcio::LCCollectionVec(lcio::LCIO::MCPARTICLE);
+    mcparticles->reserve(mcparticle_coll->size());
+    k4EDM4hep2LcioConv::detail::mapReserve(mc_particles_vec, mcparticle_coll->size());
 
     for (const auto& edm_mcp : (*mcparticle_coll)) {
       auto* lcio_mcp = new lcio::MCParticleImpl;
@@ -707,6 +658,148 @@ namespace EDM4hep2LCIOConv {
     return mcparticles;
   }
 
+  namespace detail {
+    template<typename ObjectMappingT, typename CollT>
+    lcio::LCCollectionVec* convertAs(
+      const podio::CollectionBase* coll,
+      const std::string& cellIDStr,
+      ObjectMappingT& objectMappings,
+      lcio::LCEventImpl* lcioEvent)
+    {
+      return EdmTypeTraits<CollT>::convert(static_cast<const CollT*>(coll), cellIDStr, objectMappings, lcioEvent);
+    }
+
+    template<typename ObjectMappingT, typename... CollTs>
+    CollectionConverterT<ObjectMappingT> findCollectionConverter(std::string_view valueTypeName, std::tuple<CollTs...>*)
+    {
+      static_assert(
+        (EdmTypeTraits<CollTs>::convertible && ...), "All known types need an EdmTypeTraits specialization");
+      CollectionConverterT<ObjectMappingT> converter = nullptr;
+      ((valueTypeName == CollTs::valueTypeName && (converter = &convertAs<ObjectMappingT, CollTs>)) || ...);
+      return converter;
+    }
+  } // namespace detail
+
+  template<typename ObjectMappingT>
+  CollectionConverterT<ObjectMappingT> getCollectionConverter(std::string_view valueTypeName)
+  {
+    return detail::findCollectionConverter<ObjectMappingT>(
+      valueTypeName, static_cast<KnownEdmCollectionTypes*>(nullptr));
+  }
+
+  template<typename CollT, typename ObjectMapT>
+  lcio::LCCollectionVec*
+  convSubsetCollection(const CollT* const subset_coll, const ObjectMapT& elemMap, const std::string& lcioTypeName)
+  {
+    auto* subsetColl = new lcio::LCCollectionVec(lcioTypeName);
+    subsetColl->setSubset(true);
+    subsetColl->reserve(subset_coll->size());
+
+    for (const auto& edmElem : *subset_coll) {
+      if (const auto lcioElem = k4EDM4hep2LcioConv::detail::mapLookupFrom(edmElem, elemMap)) {
+        subsetColl->addElement(lcioElem.value());
+      }
+      else {
+        std::cerr << "Cannot find corresponding LCIO object for an EDM4hep object in a subset collection of type "
+                  << CollT::valueTypeName << std::endl;
+      }
+    }
+
+    return subsetColl;
+  }
+
+  namespace detail {
+    template<typename ObjectMappingT, typename CollT>
+    lcio::LCCollectionVec* fillSubsetAs(const podio::CollectionBase* coll, const ObjectMappingT& objectMappings)
+    {
+      using TraitsT = EdmSubsetTraits<CollT>;
+      return convSubsetCollection(
+        static_cast<const CollT*>(coll), TraitsT::map(objectMappings), TraitsT::lcioTypeName());
+    }
+
+    template<typename ObjectMappingT, typename CollT>
+    constexpr SubsetConverterT<ObjectMappingT> subsetConverterFor()
+    {
+      if constexpr (EdmSubsetTraits<CollT>::subsettable) {
+        return &fillSubsetAs<ObjectMappingT, CollT>;
+      }
+      else {
+        return nullptr;
+      }
+    }
+
+    template<typename ObjectMappingT, typename... CollTs>
+    SubsetConverterT<ObjectMappingT> findSubsetConverter(std::string_view valueTypeName, std::tuple<CollTs...>*)
+    {
+      SubsetConverterT<ObjectMappingT> converter = nullptr;
+      ((valueTypeName == CollTs::valueTypeName && (converter = subsetConverterFor<ObjectMappingT, CollTs>(), true)) ||
+       ...);
+      return converter;
+    }
+  } // namespace detail
+
+  template<typename ObjectMappingT>
+  SubsetConverterT<ObjectMappingT> getSubsetConverter(std::string_view valueTypeName)
+  {
+    return detail::findSubsetConverter<ObjectMappingT>(valueTypeName, static_cast<KnownEdmCollectionTypes*>(nullptr));
+  }
+
+  template<typename RecoPartMapT, typename VertexMapT>
+  void linkStartVertices(RecoPartMapT& recoparticles_vec, const VertexMapT& vertex_vec)
+  {
+    for (auto& [lcio_rp, edm_rp] : recoparticles_vec) {
+      if (lcio_rp->getStartVertex() == nullptr) {
+        if (edm_rp.getStartVertex().isAvailable()) {
+          if (const auto lcio_vertex = k4EDM4hep2LcioConv::detail::mapLookupFrom(edm_rp.getStartVertex(), vertex_vec)) {
+            lcio_rp->setStartVertex(lcio_vertex.value());
+          }
+        }
+      }
+    }
+  }
+
+  // We loop over all pairs of lcio and edm4hep simcalo hits and add the
+  // contributions, by now MCParticle collection(s) should be converted!
+  template<typename SimCaloHitMapT, typename MCPartMapT>
+  void convCaloHitContributions(SimCaloHitMapT& sim_calo_hits_vec, const MCPartMapT& mcparticles_vec)
+  {
+    for (auto& [lcio_sch, edm_sch] : sim_calo_hits_vec) {
+      // add associated Contributions (MCParticles)
+      for (int i = 0; i < edm_sch.contributions_size(); ++i) {
+        const auto& contrib = edm_sch.getContributions(i);
+        if (not contrib.isAvailable()) {
+          // We need a logging library independent of Gaudi for this!
+          // std::cout << "WARNING: CaloHit Contribution is not available!" << std::endl;
+          continue;
+        }
+        auto edm_contrib_mcp = contrib.getParticle();
+        std::array<float, 3> step_position {
+          contrib.getStepPosition()[0], contrib.getStepPosition()[1], contrib.getStepPosition()[2]};
+        bool mcp_found = false;
+        EVENT::MCParticle* lcio_mcp = nullptr;
+        if (edm_contrib_mcp.isAvailable()) {
+          // if we have the MCParticle we look for its partner
+          lcio_mcp = k4EDM4hep2LcioConv::detail::mapLookupFrom(edm_contrib_mcp, mcparticles_vec).value_or(nullptr);
+        }
+        else { // edm mcp available
+               // std::cout << "WARNING: edm4hep contribution is not available!"  << std::endl;
+        }
+        // we add contribution with whatever lcio mc particle we found
+        lcio_sch->addMCParticleContribution(
+          lcio_mcp, contrib.getEnergy(), contrib.getTime(), contrib.getPDG(), step_position.data());
+        // if (!lcio_mcp) {
+        //   std::cout << "WARNING: No MCParticle found for this contribution."
+        //             << "Make Sure MCParticles are converted! "
+        //             << edm_contrib_mcp.id()
+        //             << std::endl;
+        // }
+      } // all emd4hep contributions
+      // We need to reset the energy to the original one, because adding
+      // contributions alters the energy in LCIO
+      lcio_sch->setEnergy(edm_sch.getEnergy());
+    } // SimCaloHit
+  }
+
   template<typename ObjectMappingT>
   void FillMissingCollections(ObjectMappingT& collection_pairs)
   {
@@ -732,17 +825,6 @@ namespace EDM4hep2LCIOConv {
 
     // Fill missing ReconstructedParticle collections
     for (auto& [lcio_rp, edm_rp] : update_pairs.recoParticles) {
-      // Link Vertex
-      if (lcio_rp->getStartVertex() == nullptr) {
-        if (edm_rp.getStartVertex().isAvailable()) {
-          if (
-            const auto lcio_vertex =
-              k4EDM4hep2LcioConv::detail::mapLookupFrom(edm_rp.getStartVertex(), lookup_pairs.vertices)) {
-            lcio_rp->setStartVertex(lcio_vertex.value());
-          }
-        }
-      }
-
       // Link Tracks
       if (lcio_rp->getTracks().size() != edm_rp.tracks_size()) {
         assert(lcio_rp->getTracks().size() == 0);
@@ -781,46 +863,11 @@ namespace EDM4hep2LCIOConv {
 
     } // vertices
 
+    // Link the start Vertices of the ReconstructedParticles
+    linkStartVertices(update_pairs.recoParticles, lookup_pairs.vertices);
+
     // Fill SimCaloHit collections with contributions
-    //
-    // We loop over all pairs of lcio and edm4hep simcalo hits and add the contributions, by now MCParticle
-    // collection(s) should be converted!
-    for (auto& [lcio_sch, edm_sch] : update_pairs.simCaloHits) {
-      // add associated Contributions (MCParticles)
-      for (int i = 0; i < edm_sch.contributions_size(); ++i) {
-        const auto& contrib = edm_sch.getContributions(i);
-        if (not contrib.isAvailable()) {
-          // We need a logging library independent of Gaudi for this!
-          // std::cout << "WARNING: CaloHit Contribution is not available!" << std::endl;
-          continue;
-        }
-        auto edm_contrib_mcp = contrib.getParticle();
-        std::array<float, 3> step_position {
-          contrib.getStepPosition()[0], contrib.getStepPosition()[1], contrib.getStepPosition()[2]};
-        bool mcp_found = false;
-        EVENT::MCParticle* lcio_mcp = nullptr;
-        if (edm_contrib_mcp.isAvailable()) {
-          // if we have the MCParticle we look for its partner
-          lcio_mcp =
-            k4EDM4hep2LcioConv::detail::mapLookupFrom(edm_contrib_mcp, lookup_pairs.mcParticles).value_or(nullptr);
-        }
-        else { // edm mcp available
-               // std::cout << "WARNING: edm4hep contribution is not available!"  << std::endl;
-        }
-        // we add contribution with whatever lcio mc particle we found
-        lcio_sch->addMCParticleContribution(
-          lcio_mcp, contrib.getEnergy(), contrib.getTime(), contrib.getPDG(), step_position.data());
-        // if (!lcio_mcp) {
-        //   std::cout << "WARNING: No MCParticle found for this contribution."
-        //             << "Make Sure MCParticles are converted! "
-        //             << edm_contrib_mcp.id()
-        //             << std::endl;
-        // }
-      } // all emd4hep contributions
-      // We need to reset the energy to the original one, because adding
-      // contributions alters the energy in LCIO
-      lcio_sch->setEnergy(edm_sch.getEnergy());
-    } // SimCaloHit
+    convCaloHitContributions(update_pairs.simCaloHits, lookup_pairs.mcParticles);
 
     // Fill missing SimTrackerHit collections
     for (auto& [lcio_strh, edm_strh] : update_pairs.simTrackerHits) {
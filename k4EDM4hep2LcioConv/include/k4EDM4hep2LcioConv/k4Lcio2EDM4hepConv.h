@@ -1,7 +1,11 @@
 #ifndef K4EDM4HEP2LCIOCONV_K4LCIO2EDM4HEPCONV_H
 #define K4EDM4HEP2LCIOCONV_K4LCIO2EDM4HEPCONV_H
 
+#include "k4EDM4hep2LcioConv/CapacityPlanner.h"
+#include "k4EDM4hep2LcioConv/EventConversion.h"
+#include "k4EDM4hep2LcioConv/FieldDescriptors.h"
 #include "k4EDM4hep2LcioConv/MappingUtils.h"
+#include "k4EDM4hep2LcioConv/TaskScheduler.h"
 
 // EDM4hep
 #include "edm4hep/CaloHitContributionCollection.h"
@@ -48,22 +52,45 @@
 #include <EVENT/Vertex.h>
 #include <EVENT/LCIntVec.h>
 #include <EVENT/LCFloatVec.h>
+#include <IOIMPL/CalorimeterHitIOImpl.h>
+#include <IOIMPL/RawCalorimeterHitIOImpl.h>
+#include <IOIMPL/SimCalorimeterHitIOImpl.h>
+#include <IOIMPL/SimTrackerHitIOImpl.h>
+#include <IOIMPL/TrackStateIOImpl.h>
+#include <IOIMPL/TrackerHitIOImpl.h>
 #include <UTIL/LCIterator.h>
 #include <lcio.h>
 
 #include "podio/Frame.h"
 #include "podio/UserDataCollection.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
 #include <vector>
 
 namespace LCIO2EDM4hepConv {
+  /// The object maps preserve the insertion order, such that iterating over
+  /// them (e.g. when resolving relations) visits the objects in the order of
+  /// their original collections. This makes the conversion deterministic.
+  ///
+  /// NOTE: Up to v00-06 this was a k4EDM4hep2LcioConv::MapT (i.e. a
+  /// std::unordered_map). The FlatMap has no erase, operator[] or at, and
+  /// inserting invalidates references to its elements. Code that needs these
+  /// can still pass MapT based mappings to the templated conversion functions.
   template<typename LcioT, typename EdmT>
-  using ObjectMapT = k4EDM4hep2LcioConv::MapT<LcioT, EdmT>;
+  using ObjectMapT = k4EDM4hep2LcioConv::FlatMapT<LcioT, EdmT>;
 
   /**
    * Maping holding all the original and converted objects in a 1:1 mapping in a
@@ -83,25 +110,204 @@ namespace LCIO2EDM4hepConv {
     ObjectMapT<lcio::MCParticle*, edm4hep::MutableMCParticle> mcParticles {};
     ObjectMapT<lcio::TrackerHitPlane*, edm4hep::MutableTrackerHitPlane> trackerHitPlanes {};
     ObjectMapT<lcio::ParticleID*, edm4hep::MutableParticleID> particleIDs {};
+
+    /// Clear all the mappings, while keeping the allocated memory around
+    void clear();
+
+    /// Insert all the mappings from other into this one
+    void merge(const LcioEdmTypeMapping& other);
+
+    /// Call func(name, map) for all the contained mappings
+    template<typename FuncT>
+    void forEachMap(FuncT&& func)
+    {
+      func("tracks", tracks);
+      func("trackerHits", trackerHits);
+      func("simTrackerHits", simTrackerHits);
+      func("caloHits", caloHits);
+      func("rawCaloHits", rawCaloHits);
+      func("simCaloHits", simCaloHits);
+      func("tpcHits", tpcHits);
+      func("clusters", clusters);
+      func("vertices", vertices);
+      func("recoParticles", recoParticles);
+      func("mcParticles", mcParticles);
+      func("trackerHitPlanes", trackerHitPlanes);
+      func("particleIDs", particleIDs);
+    }
   };
 
   using CollNamePair = std::tuple<std::string, std::unique_ptr<podio::CollectionBase>>;
 
-  /*
-   * Convert a LCRunHeader to EDM4hep as a frame.
+  /**
+   * Interned ids for the LCIO collection types that are known to the
+   * conversion. Used to dispatch to the correct conversion function without
+   * comparing type name strings.
+   */
+  enum class LcioTypeId : std::uint8_t {
+    Unknown,
+    MCParticle,
+    ReconstructedParticle,
+    Vertex,
+    Track,
+    Cluster,
+    SimCalorimeterHit,
+    RawCalorimeterHit,
+    CalorimeterHit,
+    SimTrackerHit,
+    TPCHit,
+    TrackerHit,
+    TrackerHitPlane,
+    LCIntVec,
+    LCFloatVec,
+    LCRelation,
+  };
+
+  /// Get the interned id for an LCIO type name (as returned by
+  /// LCCollection::getTypeName or used in the FromType and ToType parameters of
+  /// LCRelations)
+  LcioTypeId getLcioTypeId(const std::string& typeName);
+
+  /// Function converting a (non-subset) LCIO collection
+  template<typename ObjectMappingT>
+  using CollectionConverterT =
+    std::vector<CollNamePair> (*)(const std::string& name, EVENT::LCCollection* coll, ObjectMappingT& typeMapping);
+
+  /// Function filling a subset collection from an LCIO subset collection
+  template<typename ObjectMappingT>
+  using SubsetConverterT =
+    std::unique_ptr<podio::CollectionBase> (*)(EVENT::LCCollection* coll, const ObjectMappingT& typeMapping);
+
+  /// Function converting an LCRelation collection into an Association collection
+  template<typename ObjectMappingT>
+  using AssociationConverterT =
+    std::unique_ptr<podio::CollectionBase> (*)(EVENT::LCCollection* relations, const ObjectMappingT& typeMapping);
+
+  /**
+   * Get the function that converts a collection of the passed type, or a
+   * nullptr if there is no known conversion for it.
    */
-  podio::Frame convertRunHeader(EVENT::LCRunHeader* rheader);
+  template<typename ObjectMappingT>
+  CollectionConverterT<ObjectMappingT> getCollectionConverter(LcioTypeId typeId);
 
   /**
-   * Convert a complete LCEvent from LCIO to EDM4hep.
-   *
-   * A second, optional argument can be passed to limit the collections to
-   * convert to the subset that is passed. NOTE: There is an implicit assumption
-   * here that collsToConvert only contains collection names that are present in
-   * the passed evt. There is no exception handling internally to guard against
-   * collections that are missing.
+   * Get the function that fills a subset collection of the passed type, or a
+   * nullptr if there is no known conversion for it.
+   */
+  template<typename ObjectMappingT>
+  SubsetConverterT<ObjectMappingT> getSubsetConverter(LcioTypeId typeId);
+
+  /**
+   * Get the function that converts an LCRelation collection with the passed
+   * FromType and ToType, or a nullptr if there is no known conversion for it.
    */
-  podio::Frame convertEvent(EVENT::LCEvent* evt, const std::vector<std::string>& collsToConvert = {});
+  template<typename ObjectMappingT>
+  AssociationConverterT<ObjectMappingT> getAssociationConverter(LcioTypeId fromType, LcioTypeId toType);
+
+  // convertRunHeader and convertEvent are declared in EventConversion.h
+
+  /**
+   * Stateful converter for complete LCEvents.
+   *
+   * Converting an event in the same way as convertEvent, but keeping the
+   * object mappings and other internal bookkeeping structures alive between
+   * events. They are cleared after each event, but without releasing their
+   * memory, such that converting many events in a row does not have to grow
+   * these structures from scratch for every event. Additionally, the sizes of
+   * the mappings are recorded to reserve enough space for them up front in
+   * the following events. The conversion function for each collection is
+   * looked up once per collection name and then cached.
+   *
+   * Optionally a TaskScheduler can be passed, which is then used to convert
+   * the collections of an event in parallel. Each collection is converted into
+   * a mapping shard of its own and the shards are merged once all collections
+   * are converted. After that, filling the subset collections, resolving the
+   * relations (per type), creating the associations and the
+   * CaloHitContributions run in parallel as well, since they only read the
+   * mappings and modify disjoint sets of objects. The resulting Frame is the
+   * same as without a TaskScheduler.
+   *
+   * NOTE: Not thread safe. Use one EventConverter per thread.
+   */
+  class EventConverter {
+  public:
+    EventConverter() = default;
+
+    /// Use the scheduler to convert the contents of each event in parallel.
+    /// The scheduler has to outlive the EventConverter
+    explicit EventConverter(k4EDM4hep2LcioConv::TaskScheduler& scheduler) : m_scheduler(&scheduler) {}
+
+    /**
+     * Convert a complete LCEvent. See convertEvent for more details on the
+     * arguments.
+     */
+    podio::Frame convert(EVENT::LCEvent* evt, const std::vector<std::string>& collsToConvert = {});
+
+    /// Get the statistics of the capacity planning for the object mappings
+    const k4EDM4hep2LcioConv::CapacityPlanner::Stats& capacityStats() const { return m_capacityPlanner.stats(); }
+
+  private:
+    /// How to convert a collection with a given name. Computed when a name is
+    /// encountered for the first time and only recomputed if the type of the
+    /// collection changes
+    struct DispatchEntry {
+      std::string typeName {};
+      LcioTypeId typeId {LcioTypeId::Unknown};
+      CollectionConverterT<LcioEdmTypeMapping> convert {nullptr};
+      SubsetConverterT<LcioEdmTypeMapping> fillSubset {nullptr};
+    };
+
+    /// How to convert an LCRelation collection with a given name
+    struct AssociationDispatchEntry {
+      std::string fromType {};
+      std::string toType {};
+      AssociationConverterT<LcioEdmTypeMapping> convert {nullptr};
+    };
+
+    /// Clear all internal state for the next event
+    void reset();
+
+    /// Get the (possibly cached) dispatch entry for a collection
+    const DispatchEntry& getDispatchEntry(const std::string& name, const std::string& typeName);
+
+    /// Convert all the LCRelation collections in m_lcRelations
+    std::vector<CollNamePair> createAssociations();
+
+    /// Run all tasks, either one after the other or in parallel if there is a
+    /// scheduler, and clear them afterwards
+    void runTasks(std::vector<std::function<void()>>& tasks);
+
+    /// A (non-subset) collection that has to be converted
+    struct PendingConversion {
+      const std::string* name {nullptr};
+      EVENT::LCCollection* coll {nullptr};
+      CollectionConverterT<LcioEdmTypeMapping> convert {nullptr};
+      std::vector<CollNamePair> result {};
+    };
+
+    /// A subset collection that has to be filled
+    struct PendingSubset {
+      const std::string* name {nullptr};
+      EVENT::LCCollection* coll {nullptr};
+      SubsetConverterT<LcioEdmTypeMapping> fillSubset {nullptr};
+      std::unique_ptr<podio::CollectionBase> result {};
+    };
+
+    k4EDM4hep2LcioConv::CapacityPlanner m_capacityPlanner {};
+    std::unordered_map<std::string, DispatchEntry> m_dispatchPlan {};
+    std::unordered_map<std::string, AssociationDispatchEntry> m_associationPlan {};
+    LcioEdmTypeMapping m_typeMapping {};
+    std::vector<CollNamePair> m_edmEvent {};
+    std::vector<std::pair<std::string, EVENT::LCCollection*>> m_lcRelations {};
+
+    k4EDM4hep2LcioConv::TaskScheduler* m_scheduler {nullptr};
+    /// Per collection mappings that are used for converting in parallel. Kept
+    /// alive between events to keep their memory around
+    std::vector<LcioEdmTypeMapping> m_mappingShards {};
+    std::vector<PendingConversion> m_conversions {};
+    std::vector<PendingSubset> m_subsets {};
+    std::vector<std::function<void()>> m_tasks {};
+  };
 
   /**
    * Convert an LCIOCollection by dispatching to the specific conversion
@@ -126,6 +332,28 @@ namespace LCIO2EDM4hepConv {
   template<typename ObjectMappingT, typename ObjectMappingU>
   void resolveRelations(ObjectMappingT& updateMaps, const ObjectMappingU& lookupMaps);
 
+  /**
+   * Resolve all relations in the same way as resolveRelations, but run the
+   * resolving for the different types concurrently using the scheduler. The
+   * results are the same as for the sequential version.
+   */
+  template<typename ObjectMappingT>
+  void resolveRelations(ObjectMappingT& typeMapping, k4EDM4hep2LcioConv::TaskScheduler& scheduler);
+
+  template<typename ObjectMappingT, typename ObjectMappingU>
+  void resolveRelations(
+    ObjectMappingT& updateMaps,
+    const ObjectMappingU& lookupMaps,
+    k4EDM4hep2LcioConv::TaskScheduler& scheduler);
+
+  /**
+   * Call func with one callable for each type of objects that has relations
+   * to resolve. Each of these callables only modifies the objects of one type
+   * (and only reads the lookupMaps), so they can run concurrently.
+   */
+  template<typename ObjectMappingT, typename ObjectMappingU, typename FuncT>
+  void forEachRelationResolver(ObjectMappingT& updateMaps, const ObjectMappingU& lookupMaps, FuncT&& func);
+
   /**
    * Convert LCRelation collections into the corresponding Association collections in EDM4hep
    */
@@ -169,6 +397,14 @@ namespace LCIO2EDM4hepConv {
    */
   edm4hep::TrackState convertTrackState(const EVENT::TrackState* trackState);
 
+  /**
+   * Convert all the passed TrackStates in one go and append them to
+   * edmTrackStates. The virtual LCIO interface is bypassed for all
+   * TrackStates that have the same concrete type as the first one. This is
+   * checked for each TrackState, the others are converted via the interface.
+   */
+  void convertTrackStates(const EVENT::TrackStateVec& trackStates, std::vector<edm4hep::TrackState>& edmTrackStates);
+
   /**
    * Convert a ParticleID object.
    *
@@ -214,6 +450,9 @@ namespace LCIO2EDM4hepConv {
   /**
    * Convert a SimTrackerHit collection and return the resulting collection.
    * Simultaneously populates the mapping from LCIO to EDM4hep objects.
+   * Large collections are converted in parallel chunks if this is called from
+   * a task of a k4EDM4hep2LcioConv::TaskScheduler (see
+   * detail::convertFromData).
    */
   template<typename SimTrHitMapT>
   std::unique_ptr<edm4hep::SimTrackerHitCollection>
@@ -254,6 +493,9 @@ namespace LCIO2EDM4hepConv {
   /**
    * Convert a SimCalorimeterHit collection and return the resulting collection.
    * Simultaneously populates the mapping from LCIO to EDM4hep objects.
+   * Large collections are converted in parallel chunks if this is called from
+   * a task of a k4EDM4hep2LcioConv::TaskScheduler (see
+   * detail::convertFromData).
    */
   template<typename HitMapT>
   std::unique_ptr<edm4hep::SimCalorimeterHitCollection>
@@ -270,6 +512,9 @@ namespace LCIO2EDM4hepConv {
   /**
    * Convert a CalorimeterHit collection and return the resulting collection.
    * Simultaneously populates the mapping from LCIO to EDM4hep objects.
+   * Large collections are converted in parallel chunks if this is called from
+   * a task of a k4EDM4hep2LcioConv::TaskScheduler (see
+   * detail::convertFromData).
    */
   template<typename HitMapT>
   std::unique_ptr<edm4hep::CalorimeterHitCollection>
@@ -337,6 +582,11 @@ namespace LCIO2EDM4hepConv {
    * Creates the CaloHitContributions for all SimCaloHits.
    * has to be done this way, since the converted McParticles are needeed.
    * The contributions are also attached to their corresponding SimCalorimeterHits.
+   *
+   * The contents of all contributions are read first (see
+   * detail::CaloHitContributionArrays), before the EDM4hep objects are created
+   * from them in one go. If the MCParticle mapping does not support fast
+   * lookups, an index is built from it once.
    */
   template<typename HitMapT, typename MCParticleMapT>
   std::unique_ptr<edm4hep::CaloHitContributionCollection> createCaloHitContributions(
@@ -379,6 +629,12 @@ namespace LCIO2EDM4hepConv {
 
   /**
    * Resolve the relations for Tracks
+   *
+   * NOTE: The TPCHit map is unused, since an LCIO TPCHit is not a TrackerHit
+   * and can never be attached to a Track. The TrackerHitPlane map is unused,
+   * since an edm4hep::Track can only point to edm4hep::TrackerHits. Hits that
+   * cannot be found in the TrackerHit map are left out and reported with one
+   * summary message per call.
    */
   template<typename TrackMapT, typename TrackHitMapT, typename TPCHitMapT, typename THPlaneHitMapT>
   void resolveRelationsTracks(
@@ -393,8 +649,325 @@ namespace LCIO2EDM4hepConv {
   template<typename VertexMapT, typename RecoParticleMapT>
   void resolveRelationsVertices(VertexMapT& vertexMap, const RecoParticleMapT& recoparticleMap);
 
+  namespace detail {
+    /**
+     * Call func(elem, concreteElem) for all elements of an LCIO collection,
+     * where elem is the element as LcioT* (e.g. for inserting it into the
+     * object mappings) and concreteElem is the same element for reading its
+     * contents. If the first element is of one of the ConcreteTs, concreteElem
+     * is of that type for all elements of that type, such that the getters can
+     * be called without going through the virtual LcioT interface. Otherwise
+     * concreteElem is a const LcioT*.
+     */
+    template<typename LcioT, typename... ConcreteTs, typename FuncT>
+    void forEachElement(EVENT::LCCollection* coll, FuncT&& func);
+
+    /// Same as above for a vector of LCIO objects
+    template<typename LcioT, typename... ConcreteTs, typename FuncT>
+    void forEachElement(const std::vector<LcioT*>& elements, FuncT&& func);
+
+    /**
+     * The contents of the CaloHitContributions of a list of SimCalorimeterHits
+     * as structure of arrays. The contributions of the i-th hit are the ones
+     * in [offsets[i], offsets[i + 1]).
+     */
+    struct CaloHitContributionArrays {
+      std::vector<std::size_t> offsets {};
+      std::vector<int> PDG {};
+      std::vector<float> energy {};
+      std::vector<float> time {};
+      std::vector<edm4hep::Vector3f> stepPosition {};
+      std::vector<EVENT::MCParticle*> particle {};
+
+      /// Count the contributions of all hits and size the arrays accordingly
+      void allocate(const std::vector<EVENT::SimCalorimeterHit*>& hits);
+
+      /// Read the contents of the contributions of all hits. Has to be called
+      /// after allocate with the same hits
+      void fill(const std::vector<EVENT::SimCalorimeterHit*>& hits);
+    };
+
+    /// Collections with at least this many elements are converted in parallel
+    /// chunks of conversionChunkSize elements by convertFromData
+    constexpr unsigned chunkedConversionThreshold = 1u << 16;
+    constexpr unsigned conversionChunkSize = 1u << 14;
+
+    /**
+     * Convert all elements of an LCIO collection into EDM4hep objects of a
+     * type that can be created directly from its data struct, and populate
+     * the mapping from LCIO to EDM4hep objects. toData(concreteElem) has to
+     * return the data struct for an element (see forEachElement).
+     *
+     * If the collection has at least chunkedConversionThreshold elements and
+     * this is called from a task of a k4EDM4hep2LcioConv::TaskScheduler, the
+     * data is read from the LCIO objects in parallel chunks. Creating the
+     * EDM4hep objects and populating the mapping happens sequentially in
+     * both cases, such that the results are the same.
+     */
+    template<typename CollT, typename LcioT, typename... ConcreteTs, typename ObjectMapT, typename ToDataF>
+    std::unique_ptr<CollT>
+    convertFromData(const std::string& name, EVENT::LCCollection* coll, ObjectMapT& objectMap, ToDataF&& toData);
+
+    /// Convert a TrackState, where LcioT is either EVENT::TrackState or one of
+    /// its concrete implementations
+    template<typename LcioT>
+    edm4hep::TrackState convertTrackState(const LcioT* trackState);
+
+    template<typename CollT>
+    std::vector<CollNamePair> singleCollection(const std::string& name, std::unique_ptr<CollT> coll)
+    {
+      std::vector<CollNamePair> retColls;
+      retColls.emplace_back(name, std::move(coll));
+      return retColls;
+    }
+
+    /// Number of LcioTypeIds. LCRelation has to remain the last one
+    constexpr std::size_t NLcioTypeIds = static_cast<std::size_t>(LcioTypeId::LCRelation) + 1;
+  } // namespace detail
+
+  /**
+   * Compile time registry of the LCIO types that are known to the conversion.
+   * Each specialization ties together the interned id, the LCIO type name, the
+   * EDM4hep collection type, the object mapping member holding the converted
+   * objects and the conversion function. The dispatch tables for converting
+   * collections and filling subset collections are generated from this.
+   *
+   * When adding a new type a specialization has to be added here (and a new
+   * member to LcioEdmTypeMapping if necessary).
+   */
+  template<LcioTypeId Id>
+  struct LcioTypeTraits {
+    static constexpr std::string_view typeName {};
+    /// Whether there is a conversion for collections of this type
+    static constexpr bool convertible = false;
+    /// Whether subset collections of this type can be filled
+    static constexpr bool subsettable = false;
+  };
+
+#define K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(ID, EDMCOLL, MEMBER, CONVERT)                                      \
+  template<>                                                                                                   \
+  struct LcioTypeTraits<LcioTypeId::ID> {                                                                      \
+    static constexpr std::string_view typeName = #ID;                                                          \
+    static constexpr bool convertible = true;                                                                  \
+    static constexpr bool subsettable = true;                                                                  \
+    using edm_collection_type = EDMCOLL;                                                                       \
+    template<typename ObjectMappingT>                                                                          \
+    static auto& map(ObjectMappingT& typeMapping)                                                              \
+    {                                                                                                          \
+      return typeMapping.MEMBER;                                                                               \
+    }                                                                                                          \
+    template<typename ObjectMappingT>                                                                          \
+    static std::vector<CollNamePair>                                                                           \
+    convert(const std::string& name, EVENT::LCCollection* coll, ObjectMappingT& typeMapping)                   \
+    {                                                                                                          \
+      return CONVERT;                                                                                          \
+    }                                                                                                          \
+  };
+
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    MCParticle,
+    edm4hep::MCParticleCollection,
+    mcParticles,
+    detail::singleCollection(name, convertMCParticles(name, coll, typeMapping.mcParticles)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    ReconstructedParticle,
+    edm4hep::ReconstructedParticleCollection,
+    recoParticles,
+    convertReconstructedParticles(name, coll, typeMapping.recoParticles, typeMapping.particleIDs))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    Vertex,
+    edm4hep::VertexCollection,
+    vertices,
+    detail::singleCollection(name, convertVertices(name, coll, typeMapping.vertices)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    Track,
+    edm4hep::TrackCollection,
+    tracks,
+    detail::singleCollection(name, convertTracks(name, coll, typeMapping.tracks)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    Cluster,
+    edm4hep::ClusterCollection,
+    clusters,
+    convertClusters(name, coll, typeMapping.clusters, typeMapping.particleIDs))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    SimCalorimeterHit,
+    edm4hep::SimCalorimeterHitCollection,
+    simCaloHits,
+    detail::singleCollection(name, convertSimCalorimeterHits(name, coll, typeMapping.simCaloHits)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    RawCalorimeterHit,
+    edm4hep::RawCalorimeterHitCollection,
+    rawCaloHits,
+    detail::singleCollection(name, convertRawCalorimeterHits(name, coll, typeMapping.rawCaloHits)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    CalorimeterHit,
+    edm4hep::CalorimeterHitCollection,
+    caloHits,
+    detail::singleCollection(name, convertCalorimeterHits(name, coll, typeMapping.caloHits)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    SimTrackerHit,
+    edm4hep::SimTrackerHitCollection,
+    simTrackerHits,
+    detail::singleCollection(name, convertSimTrackerHits(name, coll, typeMapping.simTrackerHits)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    TPCHit,
+    edm4hep::RawTimeSeriesCollection,
+    tpcHits,
+    detail::singleCollection(name, convertTPCHits(name, coll, typeMapping.tpcHits)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    TrackerHit,
+    edm4hep::TrackerHitCollection,
+    trackerHits,
+    detail::singleCollection(name, convertTrackerHits(name, coll, typeMapping.trackerHits)))
+  K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS(
+    TrackerHitPlane,
+    edm4hep::TrackerHitPlaneCollection,
+    trackerHitPlanes,
+    detail::singleCollection(name, convertTrackerHitPlanes(name, coll, typeMapping.trackerHitPlanes)))
+
+#undef K4EDM4HEP2LCIOCONV_LCIO_TYPE_TRAITS
+
+  template<>
+  struct LcioTypeTraits<LcioTypeId::LCIntVec> {
+    static constexpr std::string_view typeName = "LCIntVec";
+    static constexpr bool convertible = true;
+    static constexpr bool subsettable = false;
+    template<typename ObjectMappingT>
+    static std::vector<CollNamePair> convert(const std::string& name, EVENT::LCCollection* coll, ObjectMappingT&)
+    {
+      return convertLCVec<EVENT::LCIntVec>(name, coll);
+    }
+  };
+
+  template<>
+  struct LcioTypeTraits<LcioTypeId::LCFloatVec> {
+    static constexpr std::string_view typeName = "LCFloatVec";
+    static constexpr bool convertible = true;
+    static constexpr bool subsettable = false;
+    template<typename ObjectMappingT>
+    static std::vector<CollNamePair> convert(const std::string& name, EVENT::LCCollection* coll, ObjectMappingT&)
+    {
+      return convertLCVec<EVENT::LCFloatVec>(name, coll);
+    }
+  };
+
+  /// LCRelations are only known by name. They are converted via the
+  /// AssociationTraits once all other collections have been converted
+  template<>
+  struct LcioTypeTraits<LcioTypeId::LCRelation> {
+    static constexpr std::string_view typeName = "LCRelation";
+    static constexpr bool convertible = false;
+    static constexpr bool subsettable = false;
+  };
+
+  /**
+   * Compile time registry of the LCRelations that can be converted to
+   * Association collections, depending on their FromType and ToType. Reverse
+   * indicates whether the order of the types is reversed w.r.t. the order in
+   * which they appear in the Association (see createAssociationCollection).
+   * The dispatch table for createAssociations is generated from this.
+   */
+  template<LcioTypeId FromId, LcioTypeId ToId>
+  struct AssociationTraits {
+    static constexpr bool convertible = false;
+  };
+
+#define K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(FROM, TO, ASSOCCOLL, REVERSE) \
+  template<>                                                              \
+  struct AssociationTraits<LcioTypeId::FROM, LcioTypeId::TO> {            \
+    static constexpr bool convertible = true;                             \
+    static constexpr bool reverse = REVERSE;                              \
+    using collection_type = ASSOCCOLL;                                    \
+  };
+
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    MCParticle,
+    ReconstructedParticle,
+    edm4hep::MCRecoParticleAssociationCollection,
+    false)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    ReconstructedParticle,
+    MCParticle,
+    edm4hep::MCRecoParticleAssociationCollection,
+    true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    CalorimeterHit,
+    SimCalorimeterHit,
+    edm4hep::MCRecoCaloAssociationCollection,
+    true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    SimCalorimeterHit,
+    CalorimeterHit,
+    edm4hep::MCRecoCaloAssociationCollection,
+    false)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(Cluster, MCParticle, edm4hep::MCRecoClusterParticleAssociationCollection, true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(MCParticle, Cluster, edm4hep::MCRecoClusterParticleAssociationCollection, false)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(MCParticle, Track, edm4hep::MCRecoTrackParticleAssociationCollection, false)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(Track, MCParticle, edm4hep::MCRecoTrackParticleAssociationCollection, true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(TrackerHit, SimTrackerHit, edm4hep::MCRecoTrackerAssociationCollection, true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(SimTrackerHit, TrackerHit, edm4hep::MCRecoTrackerAssociationCollection, false)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    SimTrackerHit,
+    TrackerHitPlane,
+    edm4hep::MCRecoTrackerHitPlaneAssociationCollection,
+    false)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    TrackerHitPlane,
+    SimTrackerHit,
+    edm4hep::MCRecoTrackerHitPlaneAssociationCollection,
+    true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    ReconstructedParticle,
+    Vertex,
+    edm4hep::RecoParticleVertexAssociationCollection,
+    true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    Vertex,
+    ReconstructedParticle,
+    edm4hep::RecoParticleVertexAssociationCollection,
+    false)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    CalorimeterHit,
+    MCParticle,
+    edm4hep::MCRecoCaloParticleAssociationCollection,
+    true)
+  K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS(
+    MCParticle,
+    CalorimeterHit,
+    edm4hep::MCRecoCaloParticleAssociationCollection,
+    false)
+
+#undef K4EDM4HEP2LCIOCONV_ASSOCIATION_TRAITS
+
 } // namespace LCIO2EDM4hepConv
 
 #include "k4EDM4hep2LcioConv/k4Lcio2EDM4hepConv.ipp"
 
+namespace LCIO2EDM4hepConv {
+  // The instantiations for the default LcioEdmTypeMapping are compiled into the
+  // library (see k4Lcio2EDM4hepConv.cpp) and do not have to be redone in every
+  // translation unit that includes this header
+  extern template std::vector<CollNamePair>
+  convertCollection(const std::string&, EVENT::LCCollection*, LcioEdmTypeMapping&);
+  extern template void resolveRelations(LcioEdmTypeMapping&);
+  extern template void resolveRelations(LcioEdmTypeMapping&, const LcioEdmTypeMapping&);
+  extern template void resolveRelations(LcioEdmTypeMapping&, k4EDM4hep2LcioConv::TaskScheduler&);
+  extern template void
+  resolveRelations(LcioEdmTypeMapping&, const LcioEdmTypeMapping&, k4EDM4hep2LcioConv::TaskScheduler&);
+  extern template std::vector<CollNamePair>
+  createAssociations(const LcioEdmTypeMapping&, const std::vector<std::pair<std::string, EVENT::LCCollection*>>&);
+  extern template std::unique_ptr<podio::CollectionBase>
+  fillSubset(EVENT::LCCollection*, const LcioEdmTypeMapping&, const std::string&);
+  extern template CollectionConverterT<LcioEdmTypeMapping> getCollectionConverter<LcioEdmTypeMapping>(LcioTypeId);
+  extern template SubsetConverterT<LcioEdmTypeMapping> getSubsetConverter<LcioEdmTypeMapping>(LcioTypeId);
+  extern template AssociationConverterT<LcioEdmTypeMapping>
+  getAssociationConverter<LcioEdmTypeMapping>(LcioTypeId, LcioTypeId);
+  extern template std::unique_ptr<edm4hep::CaloHitContributionCollection>
+  createCaloHitContributions(
+    decltype(LcioEdmTypeMapping::simCaloHits)&,
+    const decltype(LcioEdmTypeMapping::mcParticles)&);
+  extern template void convertObjectParameters(EVENT::LCEvent*, podio::Frame&);
+  extern template void convertObjectParameters(EVENT::LCRunHeader*, podio::Frame&);
+} // namespace LCIO2EDM4hepConv
+
 #endif // K4EDM4HEP2LCIOCONV_K4LCIO2EDM4HEPCONV_H
@@ -86,6 +86,7 @@ namespace LCIO2EDM4hepConv {
   convertMCParticles(const std::string& name, EVENT::LCCollection* LCCollection, MCParticleMapT& mcparticlesMap)
   {
     auto dest = std::make_unique<edm4hep::MCParticleCollection>();
+    k4EDM4hep2LcioConv::detail::mapReserve(mcparticlesMap, LCCollection->getNumberOfElements());
     for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
       auto* rval = static_cast<EVENT::MCParticle*>(LCCollection->getElementAt(i));
       auto lval = dest->create();
@@ -122,6 +123,7 @@ namespace LCIO2EDM4hepConv {
     PIDMapT& particleIDMap)
   {
     auto dest = std::make_unique<edm4hep::ReconstructedParticleCollection>();
+    k4EDM4hep2LcioConv::detail::mapReserve(recoparticlesMap, LCCollection->getNumberOfElements());
     auto particleIDs = std::make_unique<edm4hep::ParticleIDCollection>();
     for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
       auto* rval = static_cast<EVENT::ReconstructedParticle*>(LCCollection->getElementAt(i));
@@ -187,6 +189,7 @@ namespace LCIO2EDM4hepConv {
   convertVertices(const std::string& name, EVENT::LCCollection* LCCollection, VertexMapT& vertexMap)
   {
     auto dest = std::make_unique<edm4hep::VertexCollection>();
+    k4EDM4hep2LcioConv::detail::mapReserve(vertexMap, LCCollection->getNumberOfElements());
     for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
       auto* rval = static_cast<EVENT::Vertex*>(LCCollection->getElementAt(i));
       auto lval = dest->create();
@@ -220,31 +223,18 @@ namespace LCIO2EDM4hepConv {
   std::unique_ptr<edm4hep::SimTrackerHitCollection>
   convertSimTrackerHits(const std::string& name, EVENT::LCCollection* LCCollection, SimTrHitMapT& SimTrHitMap)
   {
-    auto dest = std::make_unique<edm4hep::SimTrackerHitCollection>();
-
-    for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
-      auto* rval = static_cast<EVENT::SimTrackerHit*>(LCCollection->getElementAt(i));
-      auto lval = dest->create();
-
-      uint64_t cellID = rval->getCellID1();
-      cellID = (cellID << 32) | rval->getCellID0();
-      lval.setCellID(cellID);
-      lval.setEDep(rval->getEDep());
-      lval.setTime(rval->getTime());
-      lval.setPathLength(rval->getPathLength());
-      lval.setQuality(rval->getQuality());
-      lval.setPosition(rval->getPosition());
-      lval.setMomentum(rval->getMomentum());
-
-      const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, SimTrHitMap);
-      if (!inserted) {
-        auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
-        const auto existingId = existing.id();
-        std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
-                  << " collection" << std::endl;
-      }
-    }
-    return dest;
+    return detail::convertFromData<
+      edm4hep::SimTrackerHitCollection,
+      EVENT::SimTrackerHit,
+      IOIMPL::SimTrackerHitIOImpl,
+      IMPL::SimTrackerHitImpl>(name, LCCollection, SimTrHitMap, [](const auto* hit) {
+      // Fill all data members at once, instead of going through the setters
+      edm4hep::SimTrackerHitData data {};
+      k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::SimTrackerHit>::toEdm(hit, data);
+      data.position = k4EDM4hep2LcioConv::detail::lcio_getters::getPosition::get(hit);
+      data.momentum = k4EDM4hep2LcioConv::detail::lcio_getters::getMomentum::get(hit);
+      return data;
+    });
   }
 
   template<typename HitMapT>
@@ -252,6 +242,7 @@ namespace LCIO2EDM4hepConv {
   convertTPCHits(const std::string& name, EVENT::LCCollection* LCCollection, HitMapT& TPCHitMap)
   {
     auto dest = std::make_unique<edm4hep::RawTimeSeriesCollection>();
+    k4EDM4hep2LcioConv::detail::mapReserve(TPCHitMap, LCCollection->getNumberOfElements());
 
     for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
       auto* rval = static_cast<EVENT::TPCHit*>(LCCollection->getElementAt(i));
@@ -281,30 +272,28 @@ namespace LCIO2EDM4hepConv {
   convertTrackerHits(const std::string& name, EVENT::LCCollection* LCCollection, HitMapT& TrackerHitMap)
   {
     auto dest = std::make_unique<edm4hep::TrackerHitCollection>();
-    for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
-      auto* rval = static_cast<EVENT::TrackerHit*>(LCCollection->getElementAt(i));
-      auto lval = dest->create();
-
-      uint64_t cellID = rval->getCellID1();
-      cellID = (cellID << 32) | rval->getCellID0();
-      lval.setCellID(cellID);
-      lval.setType(rval->getType());
-      lval.setQuality(rval->getQuality());
-      lval.setTime(rval->getTime());
-      lval.setEDep(rval->getEDep());
-      lval.setEDepError(rval->getEDepError());
-      lval.setPosition(rval->getPosition());
-      auto& m = rval->getCovMatrix();
-      lval.setCovMatrix({m[0], m[1], m[2], m[3], m[4], m[5]});
+    k4EDM4hep2LcioConv::detail::mapReserve(TrackerHitMap, LCCollection->getNumberOfElements());
+
+    detail::forEachElement<EVENT::TrackerHit, IOIMPL::TrackerHitIOImpl, IMPL::TrackerHitImpl>(
+      LCCollection,
+      [&](EVENT::TrackerHit* rval, const auto* hit) {
+        // Fill all data members at once, instead of going through the setters
+        edm4hep::TrackerHitData data {};
+        k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::TrackerHit>::toEdm(hit, data);
+        data.position = k4EDM4hep2LcioConv::detail::lcio_getters::getPosition::get(hit);
+        const auto& m = k4EDM4hep2LcioConv::detail::lcio_getters::getCovMatrix::get(hit);
+        data.covMatrix = {m[0], m[1], m[2], m[3], m[4], m[5]};
+        auto lval = dest->create(data);
+
+        const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, TrackerHitMap);
+        if (!inserted) {
+          auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
+          const auto existingId = existing.id();
+          std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
+                    << " collection" << std::endl;
+        }
+      });
 
-      const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, TrackerHitMap);
-      if (!inserted) {
-        auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
-        const auto existingId = existing.id();
-        std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
-                  << " collection" << std::endl;
-      }
-    }
     return dest;
   }
 
@@ -313,14 +302,13 @@ namespace LCIO2EDM4hepConv {
   convertTrackerHitPlanes(const std::string& name, EVENT::LCCollection* LCCollection, HitMapT& TrackerHitPlaneMap)
   {
     auto dest = std::make_unique<edm4hep::TrackerHitPlaneCollection>();
+    k4EDM4hep2LcioConv::detail::mapReserve(TrackerHitPlaneMap, LCCollection->getNumberOfElements());
 
     for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
       auto* rval = static_cast<EVENT::TrackerHitPlane*>(LCCollection->getElementAt(i));
       auto lval = dest->create();
 
-      uint64_t cellID = rval->getCellID1();
-      cellID = (cellID << 32) | rval->getCellID0();
-      lval.setCellID(cellID);
+      lval.setCellID(k4EDM4hep2LcioConv::combineCellID(rval->getCellID0(), rval->getCellID1()));
       lval.setType(rval->getType());
       lval.setQuality(rval->getQuality());
       lval.setTime(rval->getTime());
@@ -351,6 +339,20 @@ namespace LCIO2EDM4hepConv {
   convertTracks(const std::string& name, EVENT::LCCollection* LCCollection, TrackMapT& TrackMap)
   {
     auto dest = std::make_unique<edm4hep::TrackCollection>();
+    k4EDM4hep2LcioConv::detail::mapReserve(TrackMap, LCCollection->getNumberOfElements());
+
+    // Convert the TrackStates of all tracks into contiguous storage in one go
+    // and only attach them to the tracks below
+    std::vector<EVENT::TrackState*> lcioTrackStates;
+    std::vector<std::size_t> trackStatesBegin {0};
+    trackStatesBegin.reserve(LCCollection->getNumberOfElements() + 1);
+    for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
+      const auto& trackStates = static_cast<EVENT::Track*>(LCCollection->getElementAt(i))->getTrackStates();
+      lcioTrackStates.insert(lcioTrackStates.end(), trackStates.begin(), trackStates.end());
+      trackStatesBegin.push_back(lcioTrackStates.size());
+    }
+    std::vector<edm4hep::TrackState> edmTrackStates;
+    convertTrackStates(lcioTrackStates, edmTrackStates);
 
     for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
       auto* rval = static_cast<EVENT::Track*>(LCCollection->getElementAt(i));
@@ -363,13 +365,12 @@ namespace LCIO2EDM4hepConv {
       lval.setDEdxError(rval->getdEdxError());
       lval.setRadiusOfInnermostHit(rval->getRadiusOfInnermostHit());
 
-      auto subdetectorHitNum = rval->getSubdetectorHitNumbers();
+      const auto& subdetectorHitNum = rval->getSubdetectorHitNumbers();
       for (auto hitNum : subdetectorHitNum) {
         lval.addToSubdetectorHitNumbers(hitNum);
       }
-      auto& trackStates = rval->getTrackStates();
-      for (auto& trackState : trackStates) {
-        lval.addToTrackStates(convertTrackState(trackState));
+      for (auto j = trackStatesBegin[i]; j < trackStatesBegin[i + 1]; ++j) {
+        lval.addToTrackStates(edmTrackStates[j]);
       }
       auto quantities = edm4hep::Quantity {};
       quantities.value = rval->getdEdx();
@@ -391,27 +392,18 @@ namespace LCIO2EDM4hepConv {
   std::unique_ptr<edm4hep::SimCalorimeterHitCollection>
   convertSimCalorimeterHits(const std::string& name, EVENT::LCCollection* LCCollection, HitMapT& SimCaloHitMap)
   {
-    auto dest = std::make_unique<edm4hep::SimCalorimeterHitCollection>();
-    for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
-      auto* rval = static_cast<EVENT::SimCalorimeterHit*>(LCCollection->getElementAt(i));
-      auto lval = dest->create();
-
-      uint64_t cellID = rval->getCellID1();
-      cellID = (cellID << 32) | rval->getCellID0();
-      lval.setCellID(cellID);
-      lval.setEnergy(rval->getEnergy());
-      lval.setPosition(rval->getPosition());
-
-      const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, SimCaloHitMap);
-      if (!inserted) {
-        auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
-        const auto existingId = existing.id();
-        std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
-                  << " collection" << std::endl;
-      }
-    }
-
-    return dest;
+    return detail::convertFromData<
+      edm4hep::SimCalorimeterHitCollection,
+      EVENT::SimCalorimeterHit,
+      IOIMPL::SimCalorimeterHitIOImpl,
+      IMPL::SimCalorimeterHitImpl>(name, LCCollection, SimCaloHitMap, [](const auto* hit) {
+      // Fill all data members at once, instead of going through the setters.
+      // The contributions are attached later in createCaloHitContributions
+      edm4hep::SimCalorimeterHitData data {};
+      k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::SimCalorimeterHit>::toEdm(hit, data);
+      data.position = k4EDM4hep2LcioConv::detail::lcio_getters::getPosition::get(hit);
+      return data;
+    });
   }
 
   template<typename HitMapT>
@@ -419,25 +411,23 @@ namespace LCIO2EDM4hepConv {
   convertRawCalorimeterHits(const std::string& name, EVENT::LCCollection* LCCollection, HitMapT& rawCaloHitMap)
   {
     auto dest = std::make_unique<edm4hep::RawCalorimeterHitCollection>();
-
-    for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
-      auto* rval = static_cast<EVENT::RawCalorimeterHit*>(LCCollection->getElementAt(i));
-      auto lval = dest->create();
-
-      uint64_t cellID = rval->getCellID1();
-      cellID = (cellID << 32) | rval->getCellID0();
-      lval.setCellID(cellID);
-      lval.setAmplitude(rval->getAmplitude());
-      lval.setTimeStamp(rval->getTimeStamp());
-
-      const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, rawCaloHitMap);
-      if (!inserted) {
-        auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
-        const auto existingId = existing.id();
-        std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
-                  << " collection" << std::endl;
-      }
-    }
+    k4EDM4hep2LcioConv::detail::mapReserve(rawCaloHitMap, LCCollection->getNumberOfElements());
+
+    detail::forEachElement<EVENT::RawCalorimeterHit, IOIMPL::RawCalorimeterHitIOImpl, IMPL::RawCalorimeterHitImpl>(
+      LCCollection,
+      [&](EVENT::RawCalorimeterHit* rval, const auto* hit) {
+        edm4hep::RawCalorimeterHitData data {};
+        k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::RawCalorimeterHit>::toEdm(hit, data);
+        auto lval = dest->create(data);
+
+        const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, rawCaloHitMap);
+        if (!inserted) {
+          auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
+          const auto existingId = existing.id();
+          std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
+                    << " collection" << std::endl;
+        }
+      });
 
     return dest;
   }
@@ -446,30 +436,17 @@ namespace LCIO2EDM4hepConv {
   std::unique_ptr<edm4hep::CalorimeterHitCollection>
   convertCalorimeterHits(const std::string& name, EVENT::LCCollection* LCCollection, HitMapT& caloHitMap)
   {
-    auto dest = std::make_unique<edm4hep::CalorimeterHitCollection>();
-
-    for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
-      auto* rval = static_cast<EVENT::CalorimeterHit*>(LCCollection->getElementAt(i));
-      auto lval = dest->create();
-      uint64_t cellID = rval->getCellID1();
-      cellID = (cellID << 32) | rval->getCellID0();
-      lval.setCellID(cellID);
-      lval.setEnergy(rval->getEnergy());
-      lval.setEnergyError(rval->getEnergyError());
-      lval.setPosition(rval->getPosition());
-      lval.setTime(rval->getTime());
-      lval.setType(rval->getType());
-
-      const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, caloHitMap);
-      if (!inserted) {
-        auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
-        const auto existingId = existing.id();
-        std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
-                  << " collection" << std::endl;
-      }
-    }
-
-    return dest;
+    return detail::convertFromData<
+      edm4hep::CalorimeterHitCollection,
+      EVENT::CalorimeterHit,
+      IOIMPL::CalorimeterHitIOImpl,
+      IMPL::CalorimeterHitImpl>(name, LCCollection, caloHitMap, [](const auto* hit) {
+      // Fill all data members at once, instead of going through the setters
+      edm4hep::CalorimeterHitData data {};
+      k4EDM4hep2LcioConv::FieldDescriptor<edm4hep::CalorimeterHit>::toEdm(hit, data);
+      data.position = k4EDM4hep2LcioConv::detail::lcio_getters::getPosition::get(hit);
+      return data;
+    });
   }
 
   template<typename ClusterMapT, typename PIDMapT>
@@ -481,6 +458,7 @@ namespace LCIO2EDM4hepConv {
   {
     auto particleIDs = std::make_unique<edm4hep::ParticleIDCollection>();
     auto dest = std::make_unique<edm4hep::ClusterCollection>();
+    k4EDM4hep2LcioConv::detail::mapReserve(clusterMap, LCCollection->getNumberOfElements());
 
     for (unsigned i = 0, N = LCCollection->getNumberOfElements(); i < N; ++i) {
       auto* rval = static_cast<EVENT::Cluster*>(LCCollection->getElementAt(i));
@@ -525,87 +503,305 @@ namespace LCIO2EDM4hepConv {
     return results;
   }
 
-  template<typename ObjectMappingT>
-  std::vector<CollNamePair>
-  convertCollection(const std::string& name, EVENT::LCCollection* LCCollection, ObjectMappingT& typeMapping)
-  {
-    const auto& type = LCCollection->getTypeName();
-    std::vector<CollNamePair> retColls;
-    if (type == "MCParticle") {
-      retColls.emplace_back(name, convertMCParticles(name, LCCollection, typeMapping.mcParticles));
+  namespace detail {
+    template<typename LcioT, typename... ConcreteTs, typename ElementF, typename FuncT>
+    void forEachElementImpl(unsigned nElements, ElementF&& element, FuncT&& func)
+    {
+      if (nElements > 0) {
+        // Collections usually only contain one concrete type, so take the one
+        // of the first element and check the others while going along, instead
+        // of going over all elements twice
+        const auto& firstType = typeid(*element(0));
+        const auto loopAs = [&](auto* tag) {
+          using ConcreteT = std::remove_pointer_t<decltype(tag)>;
+          if (firstType != typeid(ConcreteT)) {
+            return false;
+          }
+          for (unsigned i = 0; i < nElements; ++i) {
+            auto* elem = element(i);
+            if (typeid(*elem) == typeid(ConcreteT)) {
+              func(elem, static_cast<const ConcreteT*>(elem));
+            }
+            else {
+              func(elem, static_cast<const LcioT*>(elem));
+            }
+          }
+          return true;
+        };
+        if ((loopAs(static_cast<ConcreteTs*>(nullptr)) || ...)) {
+          return;
+        }
+      }
+
+      for (unsigned i = 0; i < nElements; ++i) {
+        auto* elem = element(i);
+        func(elem, static_cast<const LcioT*>(elem));
+      }
     }
-    else if (type == "ReconstructedParticle") {
-      return convertReconstructedParticles(name, LCCollection, typeMapping.recoParticles, typeMapping.particleIDs);
+
+    template<typename LcioT, typename... ConcreteTs, typename FuncT>
+    void forEachElement(EVENT::LCCollection* coll, FuncT&& func)
+    {
+      forEachElementImpl<LcioT, ConcreteTs...>(
+        coll->getNumberOfElements(),
+        [coll](unsigned i) { return static_cast<LcioT*>(coll->getElementAt(i)); },
+        func);
+    }
+
+    template<typename LcioT, typename... ConcreteTs, typename FuncT>
+    void forEachElement(const std::vector<LcioT*>& elements, FuncT&& func)
+    {
+      forEachElementImpl<LcioT, ConcreteTs...>(elements.size(), [&elements](unsigned i) { return elements[i]; }, func);
     }
-    else if (type == "Vertex") {
-      retColls.emplace_back(name, convertVertices(name, LCCollection, typeMapping.vertices));
+
+    template<typename CollT, typename LcioT, typename... ConcreteTs, typename ObjectMapT, typename ToDataF>
+    std::unique_ptr<CollT>
+    convertFromData(const std::string& name, EVENT::LCCollection* coll, ObjectMapT& objectMap, ToDataF&& toData)
+    {
+      auto dest = std::make_unique<CollT>();
+      const unsigned nElements = coll->getNumberOfElements();
+      k4EDM4hep2LcioConv::detail::mapReserve(objectMap, nElements);
+
+      const auto insert = [&](LcioT* rval, const auto& data) {
+        auto lval = dest->create(data);
+        const auto [iterator, inserted] = k4EDM4hep2LcioConv::detail::mapInsert(rval, lval, objectMap);
+        if (!inserted) {
+          auto existing = k4EDM4hep2LcioConv::detail::getMapped(iterator);
+          const auto existingId = existing.id();
+          std::cerr << "EDM4hep element  " << existingId << " did not get inserted. It belongs to the " << name
+                    << " collection" << std::endl;
+        }
+      };
+
+      auto* scheduler = k4EDM4hep2LcioConv::TaskScheduler::current();
+      if (scheduler == nullptr || nElements < chunkedConversionThreshold) {
+        forEachElement<LcioT, ConcreteTs...>(coll, [&](LcioT* rval, const auto* elem) { insert(rval, toData(elem)); });
+        return dest;
+      }
+
+      // Neither the collection nor the mapping can be filled concurrently, so
+      // only reading the LCIO objects is split into chunks. Each chunk checks
+      // for the concrete type on its own
+      using DataT = std::decay_t<decltype(toData(std::declval<const LcioT*>()))>;
+      std::vector<DataT> data(nElements);
+      k4EDM4hep2LcioConv::TaskScheduler::TaskGroup group(*scheduler);
+      for (unsigned begin = 0; begin < nElements; begin += conversionChunkSize) {
+        const auto end = std::min(begin + conversionChunkSize, nElements);
+        group.run([&data, &toData, coll, begin, end]() {
+          auto index = begin;
+          forEachElementImpl<LcioT, ConcreteTs...>(
+            end - begin,
+            [coll, begin](unsigned i) { return static_cast<LcioT*>(coll->getElementAt(begin + i)); },
+            [&](LcioT*, const auto* elem) { data[index++] = toData(elem); });
+        });
+      }
+      group.wait();
+
+      for (unsigned i = 0; i < nElements; ++i) {
+        insert(static_cast<LcioT*>(coll->getElementAt(i)), data[i]);
+      }
+      return dest;
     }
-    else if (type == "Track") {
-      retColls.emplace_back(name, convertTracks(name, LCCollection, typeMapping.tracks));
+
+    template<typename LcioT>
+    edm4hep::TrackState convertTrackState(const LcioT* trackState)
+    {
+      namespace getters = k4EDM4hep2LcioConv::detail::lcio_getters;
+
+      auto edmtrackState = edm4hep::TrackState {};
+      edmtrackState.location = getters::getLocation::get(trackState);
+      edmtrackState.D0 = getters::getD0::get(trackState);
+      edmtrackState.phi = getters::getPhi::get(trackState);
+      edmtrackState.omega = getters::getOmega::get(trackState);
+      edmtrackState.Z0 = getters::getZ0::get(trackState);
+      edmtrackState.tanLambda = getters::getTanLambda::get(trackState);
+      // not available in lcio
+      edmtrackState.time = -1;
+      const auto* refPoint = getters::getReferencePoint::get(trackState);
+      edmtrackState.referencePoint = edm4hep::Vector3f(refPoint[0], refPoint[1], refPoint[2]);
+      // LCIO only has the 15 elements of the 5x5 covariance matrix. The
+      // remaining ones (involving the time) stay zero
+      const auto& covMatrix = getters::getCovMatrix::get(trackState);
+      std::copy_n(covMatrix.begin(), 15, edmtrackState.covMatrix.begin());
+
+      return edmtrackState;
     }
-    else if (type == "Cluster") {
-      return convertClusters(name, LCCollection, typeMapping.clusters, typeMapping.particleIDs);
+
+    template<typename ObjectMappingT, LcioTypeId Id>
+    constexpr CollectionConverterT<ObjectMappingT> collectionConverterFor()
+    {
+      if constexpr (LcioTypeTraits<Id>::convertible) {
+        return &LcioTypeTraits<Id>::template convert<ObjectMappingT>;
+      }
+      else {
+        return nullptr;
+      }
     }
-    else if (type == "SimCalorimeterHit") {
-      retColls.emplace_back(name, convertSimCalorimeterHits(name, LCCollection, typeMapping.simCaloHits));
+
+    template<typename ObjectMappingT, std::size_t... Ids>
+    constexpr auto makeCollectionConverterTable(std::index_sequence<Ids...>)
+    {
+      return std::array<CollectionConverterT<ObjectMappingT>, sizeof...(Ids)> {
+        collectionConverterFor<ObjectMappingT, static_cast<LcioTypeId>(Ids)>()...};
     }
-    else if (type == "RawCalorimeterHit") {
-      retColls.emplace_back(name, convertRawCalorimeterHits(name, LCCollection, typeMapping.rawCaloHits));
+
+    template<typename ObjectMappingT, LcioTypeId Id>
+    std::unique_ptr<podio::CollectionBase> fillSubsetAs(EVENT::LCCollection* coll, const ObjectMappingT& typeMapping)
+    {
+      using TraitsT = LcioTypeTraits<Id>;
+      return handleSubsetColl<typename TraitsT::edm_collection_type>(coll, TraitsT::map(typeMapping));
     }
-    else if (type == "CalorimeterHit") {
-      retColls.emplace_back(name, convertCalorimeterHits(name, LCCollection, typeMapping.caloHits));
+
+    template<typename ObjectMappingT, LcioTypeId Id>
+    constexpr SubsetConverterT<ObjectMappingT> subsetConverterFor()
+    {
+      if constexpr (LcioTypeTraits<Id>::subsettable) {
+        return &fillSubsetAs<ObjectMappingT, Id>;
+      }
+      else {
+        return nullptr;
+      }
     }
-    else if (type == "SimTrackerHit") {
-      retColls.emplace_back(name, convertSimTrackerHits(name, LCCollection, typeMapping.simTrackerHits));
+
+    template<typename ObjectMappingT, std::size_t... Ids>
+    constexpr auto makeSubsetConverterTable(std::index_sequence<Ids...>)
+    {
+      return std::array<SubsetConverterT<ObjectMappingT>, sizeof...(Ids)> {
+        subsetConverterFor<ObjectMappingT, static_cast<LcioTypeId>(Ids)>()...};
     }
-    else if (type == "TPCHit") {
-      retColls.emplace_back(name, convertTPCHits(name, LCCollection, typeMapping.tpcHits));
+
+    template<typename ObjectMappingT, LcioTypeId FromId, LcioTypeId ToId>
+    std::unique_ptr<podio::CollectionBase>
+    createAssociationsAs(EVENT::LCCollection* relations, const ObjectMappingT& typeMapping)
+    {
+      using TraitsT = AssociationTraits<FromId, ToId>;
+      return createAssociationCollection<typename TraitsT::collection_type, TraitsT::reverse>(
+        relations, LcioTypeTraits<FromId>::map(typeMapping), LcioTypeTraits<ToId>::map(typeMapping));
     }
-    else if (type == "TrackerHit") {
-      retColls.emplace_back(name, convertTrackerHits(name, LCCollection, typeMapping.trackerHits));
+
+    template<typename ObjectMappingT, LcioTypeId FromId, LcioTypeId ToId>
+    constexpr AssociationConverterT<ObjectMappingT> associationConverterFor()
+    {
+      if constexpr (AssociationTraits<FromId, ToId>::convertible) {
+        return &createAssociationsAs<ObjectMappingT, FromId, ToId>;
+      }
+      else {
+        return nullptr;
+      }
     }
-    else if (type == "TrackerHitPlane") {
-      retColls.emplace_back(name, convertTrackerHitPlanes(name, LCCollection, typeMapping.trackerHitPlanes));
+
+    template<typename ObjectMappingT, std::size_t FromId, std::size_t... ToIds>
+    constexpr auto makeAssociationConverterRow(std::index_sequence<ToIds...>)
+    {
+      return std::array<AssociationConverterT<ObjectMappingT>, sizeof...(ToIds)> {
+        associationConverterFor<ObjectMappingT, static_cast<LcioTypeId>(FromId), static_cast<LcioTypeId>(ToIds)>()...};
     }
-    else if (type == "LCIntVec") {
-      return convertLCVec<EVENT::LCIntVec>(name, LCCollection);
+
+    template<typename ObjectMappingT, std::size_t... FromIds>
+    constexpr auto makeAssociationConverterTable(std::index_sequence<FromIds...> ids)
+    {
+      return std::array<std::array<AssociationConverterT<ObjectMappingT>, sizeof...(FromIds)>, sizeof...(FromIds)> {
+        makeAssociationConverterRow<ObjectMappingT, FromIds>(ids)...};
     }
-    else if (type == "LCFloatVec") {
-      return convertLCVec<EVENT::LCFloatVec>(name, LCCollection);
+  } // namespace detail
+
+  template<typename ObjectMappingT>
+  CollectionConverterT<ObjectMappingT> getCollectionConverter(LcioTypeId typeId)
+  {
+    static constexpr auto converters =
+      detail::makeCollectionConverterTable<ObjectMappingT>(std::make_index_sequence<detail::NLcioTypeIds> {});
+    return converters[static_cast<std::size_t>(typeId)];
+  }
+
+  template<typename ObjectMappingT>
+  std::vector<CollNamePair>
+  convertCollection(const std::string& name, EVENT::LCCollection* LCCollection, ObjectMappingT& typeMapping)
+  {
+    const auto& type = LCCollection->getTypeName();
+    if (const auto convert = getCollectionConverter<ObjectMappingT>(getLcioTypeId(type))) {
+      return convert(name, LCCollection, typeMapping);
     }
-    else if (type != "LCRelation") {
+    if (type != "LCRelation") {
       std::cerr << type << " is a collection type for which no known conversion exists." << std::endl;
     }
-    return retColls;
+    return {};
   }
 
+  namespace detail {
+    /// Get something in which the converted MCParticles can be looked up
+    /// quickly. This is the mapping itself if it supports fast lookups and an
+    /// index built from it otherwise (which is then returned by value)
+    template<typename MCParticleMapT>
+    decltype(auto) fastMCParticleLookup(const MCParticleMapT& mcparticlesMap)
+    {
+      namespace conv = k4EDM4hep2LcioConv::detail;
+      if constexpr (conv::is_map_v<MCParticleMapT> || conv::has_lookup_to_v<MCParticleMapT>) {
+        return (mcparticlesMap);
+      }
+      else {
+        k4EDM4hep2LcioConv::FlatMapT<conv::key_t<MCParticleMapT>, conv::mapped_t<MCParticleMapT>> particleIndex {};
+        particleIndex.reserve(mcparticlesMap.size());
+        for (const auto& [lcio, edm] : mcparticlesMap) {
+          particleIndex.emplace(lcio, edm);
+        }
+        return particleIndex;
+      }
+    }
+  } // namespace detail
+
   template<typename HitMapT, typename MCParticleMapT>
   std::unique_ptr<edm4hep::CaloHitContributionCollection> createCaloHitContributions(
     HitMapT& SimCaloHitMap,
     const MCParticleMapT& mcparticlesMap)
   {
     auto contrCollection = std::make_unique<edm4hep::CaloHitContributionCollection>();
+    if (SimCaloHitMap.size() == 0) {
+      return contrCollection;
+    }
+
+    std::vector<EVENT::SimCalorimeterHit*> lcioHits;
+    lcioHits.reserve(SimCaloHitMap.size());
+    for (const auto& [lcioHit, edmHit] : SimCaloHitMap) {
+      lcioHits.push_back(lcioHit);
+    }
+    detail::CaloHitContributionArrays contributions {};
+    contributions.allocate(lcioHits);
+    contributions.fill(lcioHits);
+
+    const auto& particleLookup = detail::fastMCParticleLookup(mcparticlesMap);
+    // Consecutive contributions usually stem from the same MCParticle, so only
+    // look it up if it changes
+    const EVENT::MCParticle* lastLcioParticle = nullptr;
+    std::optional<edm4hep::MCParticle> lastParticle {};
+
+    std::size_t iHit = 0;
     for (auto& [lcioHit, edmHit] : SimCaloHitMap) {
-      auto NMCParticle = lcioHit->getNMCParticles();
-      for (unsigned j = 0; j < NMCParticle; j++) {
-        auto edm_contr = contrCollection->create();
+      for (auto i = contributions.offsets[iHit]; i < contributions.offsets[iHit + 1]; ++i) {
+        edm4hep::CaloHitContributionData data {};
+        data.PDG = contributions.PDG[i];
+        data.energy = contributions.energy[i];
+        data.time = contributions.time[i];
+        data.stepPosition = contributions.stepPosition[i];
+        auto edm_contr = contrCollection->create(data);
         edmHit.addToContributions(edm_contr);
 
-        edm_contr.setPDG(lcioHit->getPDGCont(j));
-        edm_contr.setTime(lcioHit->getTimeCont(j));
-        edm_contr.setEnergy(lcioHit->getEnergyCont(j));
-        edm_contr.setStepPosition(lcioHit->getStepPosition(j));
-        auto lcioParticle = (lcioHit->getParticleCont(j));
-        if (lcioParticle != nullptr) {
-          if (const auto edm4hepParticle = k4EDM4hep2LcioConv::detail::mapLookupTo(lcioParticle, mcparticlesMap)) {
-            edm_contr.setParticle(edm4hepParticle.value());
-          }
-          else {
-            std::cerr << "Cannot find corresponding EDM4hep MCParticle for a LCIO MCParticle, "
-                      << "while trying to build CaloHitContributions " << std::endl;
-          }
+        auto* lcioParticle = contributions.particle[i];
+        if (lcioParticle == nullptr) {
+          continue;
+        }
+        if (lcioParticle != lastLcioParticle) {
+          lastLcioParticle = lcioParticle;
+          lastParticle = k4EDM4hep2LcioConv::detail::mapLookupTo(lcioParticle, particleLookup);
+        }
+        if (lastParticle) {
+          edm_contr.setParticle(lastParticle.value());
+        }
+        else {
+          std::cerr << "Cannot find corresponding EDM4hep MCParticle for a LCIO MCParticle, "
+                    << "while trying to build CaloHitContributions " << std::endl;
         }
       }
+      ++iHit;
     }
     return contrCollection;
   }
@@ -616,8 +812,8 @@ namespace LCIO2EDM4hepConv {
     int edmnum = 1;
     for (auto& [lcio, edm] : mcparticlesMap) {
       edmnum++;
-      auto daughters = lcio->getDaughters();
-      auto parents = lcio->getParents();
+      const auto& daughters = lcio->getDaughters();
+      const auto& parents = lcio->getParents();
 
       for (auto d : daughters) {
         if (d == nullptr) {
@@ -696,7 +892,7 @@ namespace LCIO2EDM4hepConv {
         }
       }
 
-      auto clusters = lcio->getClusters();
+      const auto& clusters = lcio->getClusters();
       for (auto c : clusters) {
         if (c == nullptr) {
           continue;
@@ -711,7 +907,7 @@ namespace LCIO2EDM4hepConv {
         }
       }
 
-      auto tracks = lcio->getTracks();
+      const auto& tracks = lcio->getTracks();
       for (auto t : tracks) {
         if (t == nullptr) {
           continue;
@@ -726,7 +922,7 @@ namespace LCIO2EDM4hepConv {
         }
       }
 
-      auto parents = lcio->getParticles();
+      const auto& parents = lcio->getParticles();
       for (auto p : parents) {
         if (p == nullptr) {
           continue;
@@ -747,10 +943,10 @@ namespace LCIO2EDM4hepConv {
   void resolveRelationsClusters(ClusterMapT& clustersMap, const CaloHitMapT& caloHitMap)
   {
     for (auto& [lcio, edm] : clustersMap) {
-      auto clusters = lcio->getClusters();
-      auto calohits = lcio->getCalorimeterHits();
-      auto shape = lcio->getShape();
-      auto subdetectorEnergies = lcio->getSubdetectorEnergies();
+      const auto& clusters = lcio->getClusters();
+      const auto& calohits = lcio->getCalorimeterHits();
+      const auto& shape = lcio->getShape();
+      const auto& subdetectorEnergies = lcio->getSubdetectorEnergies();
       for (auto c : clusters) {
         if (c == nullptr) {
           continue;
@@ -789,9 +985,10 @@ namespace LCIO2EDM4hepConv {
     const TPCHitMapT&,
     const THPlaneHitMapT&)
   {
+    std::size_t nMissingHits = 0;
     for (auto& [lcio, edm] : tracksMap) {
-      auto tracks = lcio->getTracks();
-      auto trackerHits = lcio->getTrackerHits();
+      const auto& tracks = lcio->getTracks();
+      const auto& trackerHits = lcio->getTrackerHits();
       for (auto t : tracks) {
         if (t == nullptr) {
           continue;
@@ -810,37 +1007,15 @@ namespace LCIO2EDM4hepConv {
         if (const auto trHit = k4EDM4hep2LcioConv::detail::mapLookupTo(th, trackerHitMap)) {
           edm.addToTrackerHits(trHit.value());
         }
-        // else {
-        //   std::cerr << "Couldn't find trackerHit to add to Relations for tracks in edm\n"
-        //             << " This is due to it being a TrackerHitPlane or TPCHit" << std::endl;
-
-        //   // This Code looks for the trackerHit in the TPCHit Map aswell as the
-        //   // trackerHitPlane Map. Those relations can not be set for a track in
-        //   // edm4HEP. In all tests the missing trackerHits were located in
-        //   // either of these maps.
-        //   const auto tpchit = dynamic_cast<lcio::TPCHit*>(th);
-        //   const auto trackerhitplane = dynamic_cast<lcio::TrackerHitPlane*>(th);
-        //   if (tpchit != nullptr) {
-        //     const auto it = TPCHitMap.find(tpchit);
-        //     if (it != TPCHitMap.end()) {
-        //       std::cout << "trackerHit found in TPCHit map !" << std::endl;
-        //     }
-        //     else {
-        //       std::cerr << "TRACKERHIT also could not be found in TPCHit Map" << std::endl;
-        //     }
-        //   }
-        //   else if (trackerhitplane != nullptr) {
-        //     const auto it = trackerhitplaneMap.find(trackerhitplane);
-        //     if (it != trackerhitplaneMap.end()) {
-        //       std::cout << "trackerHit found in TrackerHitPlane map !" << std::endl;
-        //     }
-        //     else {
-        //       std::cerr << "TRACKERHIT also could not be found in TrackerHitPlane Map" << std::endl;
-        //     }
-        //   }
-        // }
+        else {
+          nMissingHits++;
+        }
       }
     }
+    if (nMissingHits > 0) {
+      std::cerr << "Couldn't find " << nMissingHits << " TrackerHits to add to Tracks Relations in edm "
+                << "(TrackerHitPlanes and hits from unconverted collections cannot be attached)" << std::endl;
+    }
   }
 
   template<typename VertexMapT, typename RecoParticleMapT>
@@ -870,13 +1045,47 @@ namespace LCIO2EDM4hepConv {
   template<typename ObjectMappingT, typename ObjectMappingU>
   void resolveRelations(ObjectMappingT& updateMaps, const ObjectMappingU& lookupMaps)
   {
-    resolveRelationsMCParticles(updateMaps.mcParticles, lookupMaps.mcParticles);
-    resolveRelationsRecoParticles(
-      updateMaps.recoParticles, lookupMaps.recoParticles, lookupMaps.vertices, lookupMaps.clusters, lookupMaps.tracks);
-    resolveRelationsSimTrackerHits(updateMaps.simTrackerHits, lookupMaps.mcParticles);
-    resolveRelationsClusters(updateMaps.clusters, lookupMaps.caloHits);
-    resolveRelationsTracks(updateMaps.tracks, lookupMaps.trackerHits, lookupMaps.tpcHits, lookupMaps.trackerHitPlanes);
-    resolveRelationsVertices(updateMaps.vertices, lookupMaps.recoParticles);
+    forEachRelationResolver(updateMaps, lookupMaps, [](auto&& resolve) { resolve(); });
+  }
+
+  template<typename ObjectMappingT>
+  void resolveRelations(ObjectMappingT& typeMapping, k4EDM4hep2LcioConv::TaskScheduler& scheduler)
+  {
+    resolveRelations(typeMapping, typeMapping, scheduler);
+  }
+
+  template<typename ObjectMappingT, typename ObjectMappingU>
+  void resolveRelations(
+    ObjectMappingT& updateMaps,
+    const ObjectMappingU& lookupMaps,
+    k4EDM4hep2LcioConv::TaskScheduler& scheduler)
+  {
+    k4EDM4hep2LcioConv::TaskScheduler::TaskGroup group(scheduler);
+    forEachRelationResolver(updateMaps, lookupMaps, [&group](auto&& resolve) { group.run(resolve); });
+    group.wait();
+  }
+
+  template<typename ObjectMappingT, typename ObjectMappingU, typename FuncT>
+  void forEachRelationResolver(ObjectMappingT& updateMaps, const ObjectMappingU& lookupMaps, FuncT&& func)
+  {
+    func([&updateMaps, &lookupMaps]() { resolveRelationsMCParticles(updateMaps.mcParticles, lookupMaps.mcParticles); });
+    func([&updateMaps, &lookupMaps]() {
+      resolveRelationsRecoParticles(
+        updateMaps.recoParticles,
+        lookupMaps.recoParticles,
+        lookupMaps.vertices,
+        lookupMaps.clusters,
+        lookupMaps.tracks);
+    });
+    func([&updateMaps, &lookupMaps]() {
+      resolveRelationsSimTrackerHits(updateMaps.simTrackerHits, lookupMaps.mcParticles);
+    });
+    func([&updateMaps, &lookupMaps]() { resolveRelationsClusters(updateMaps.clusters, lookupMaps.caloHits); });
+    func([&updateMaps, &lookupMaps]() {
+      resolveRelationsTracks(
+        updateMaps.tracks, lookupMaps.trackerHits, lookupMaps.tpcHits, lookupMaps.trackerHitPlanes);
+    });
+    func([&updateMaps, &lookupMaps]() { resolveRelationsVertices(updateMaps.vertices, lookupMaps.recoParticles); });
   }
 
   template<
@@ -926,6 +1135,14 @@ namespace LCIO2EDM4hepConv {
     return assocColl;
   }
 
+  template<typename ObjectMappingT>
+  AssociationConverterT<ObjectMappingT> getAssociationConverter(LcioTypeId fromType, LcioTypeId toType)
+  {
+    static constexpr auto converters =
+      detail::makeAssociationConverterTable<ObjectMappingT>(std::make_index_sequence<detail::NLcioTypeIds> {});
+    return converters[static_cast<std::size_t>(fromType)][static_cast<std::size_t>(toType)];
+  }
+
   template<typename ObjectMappingT>
   std::vector<CollNamePair> createAssociations(
     const ObjectMappingT& typeMapping,
@@ -943,85 +1160,10 @@ namespace LCIO2EDM4hepConv {
         continue;
       }
 
-      if (fromType == "MCParticle" && toType == "ReconstructedParticle") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoParticleAssociationCollection, false>(
-          relations, typeMapping.mcParticles, typeMapping.recoParticles);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "ReconstructedParticle" && toType == "MCParticle") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoParticleAssociationCollection, true>(
-          relations, typeMapping.recoParticles, typeMapping.mcParticles);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "CalorimeterHit" && toType == "SimCalorimeterHit") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoCaloAssociationCollection, true>(
-          relations, typeMapping.caloHits, typeMapping.simCaloHits);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "SimCalorimeterHit" && toType == "CalorimeterHit") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoCaloAssociationCollection, false>(
-          relations, typeMapping.simCaloHits, typeMapping.caloHits);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "Cluster" && toType == "MCParticle") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoClusterParticleAssociationCollection, true>(
-          relations, typeMapping.clusters, typeMapping.mcParticles);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "MCParticle" && toType == "Cluster") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoClusterParticleAssociationCollection, false>(
-          relations, typeMapping.mcParticles, typeMapping.clusters);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "MCParticle" && toType == "Track") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoTrackParticleAssociationCollection, false>(
-          relations, typeMapping.mcParticles, typeMapping.tracks);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "Track" && toType == "MCParticle") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoTrackParticleAssociationCollection, true>(
-          relations, typeMapping.tracks, typeMapping.mcParticles);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "TrackerHit" && toType == "SimTrackerHit") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoTrackerAssociationCollection, true>(
-          relations, typeMapping.trackerHits, typeMapping.simTrackerHits);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "SimTrackerHit" && toType == "TrackerHit") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoTrackerAssociationCollection, false>(
-          relations, typeMapping.simTrackerHits, typeMapping.trackerHits);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "SimTrackerHit" && toType == "TrackerHitPlane") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoTrackerHitPlaneAssociationCollection, false>(
-          relations, typeMapping.simTrackerHits, typeMapping.trackerHitPlanes);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "TrackerHitPlane" && toType == "SimTrackerHit") {
-        auto mc_a = createAssociationCollection<edm4hep::MCRecoTrackerHitPlaneAssociationCollection, true>(
-          relations, typeMapping.trackerHitPlanes, typeMapping.simTrackerHits);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "ReconstructedParticle" && toType == "Vertex") {
-        auto mc_a = createAssociationCollection<edm4hep::RecoParticleVertexAssociationCollection, true>(
-          relations, typeMapping.recoParticles, typeMapping.vertices);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "Vertex" && toType == "ReconstructedParticle") {
-        auto mc_a = createAssociationCollection<edm4hep::RecoParticleVertexAssociationCollection, false>(
-          relations, typeMapping.vertices, typeMapping.recoParticles);
-        assoCollVec.emplace_back(name, std::move(mc_a));
-      }
-      else if (fromType == "CalorimeterHit" && toType == "MCParticle") {
-        auto assoc = createAssociationCollection<edm4hep::MCRecoCaloParticleAssociationCollection, true>(
-          relations, typeMapping.caloHits, typeMapping.mcParticles);
-        assoCollVec.emplace_back(name, std::move(assoc));
-      }
-      else if (fromType == "MCParticle" && toType == "CalorimeterHit") {
-        auto assoc = createAssociationCollection<edm4hep::MCRecoCaloParticleAssociationCollection, false>(
-          relations, typeMapping.mcParticles, typeMapping.caloHits);
-        assoCollVec.emplace_back(name, std::move(assoc));
+      if (
+        const auto convert =
+          getAssociationConverter<ObjectMappingT>(getLcioTypeId(fromType), getLcioTypeId(toType))) {
+        assoCollVec.emplace_back(name, convert(relations, typeMapping));
       }
       else {
         std::cout << "Relation from: " << fromType << " to: " << toType << " (" << name
@@ -1032,49 +1174,22 @@ namespace LCIO2EDM4hepConv {
     return assoCollVec;
   }
 
+  template<typename ObjectMappingT>
+  SubsetConverterT<ObjectMappingT> getSubsetConverter(LcioTypeId typeId)
+  {
+    static constexpr auto converters =
+      detail::makeSubsetConverterTable<ObjectMappingT>(std::make_index_sequence<detail::NLcioTypeIds> {});
+    return converters[static_cast<std::size_t>(typeId)];
+  }
+
   template<typename ObjectMappingT>
   std::unique_ptr<podio::CollectionBase>
   fillSubset(EVENT::LCCollection* LCCollection, const ObjectMappingT& typeMapping, const std::string& type)
   {
-    if (type == "MCParticle") {
-      return handleSubsetColl<edm4hep::MCParticleCollection>(LCCollection, typeMapping.mcParticles);
-    }
-    else if (type == "ReconstructedParticle") {
-      return handleSubsetColl<edm4hep::ReconstructedParticleCollection>(LCCollection, typeMapping.recoParticles);
-    }
-    else if (type == "Vertex") {
-      return handleSubsetColl<edm4hep::VertexCollection>(LCCollection, typeMapping.vertices);
-    }
-    else if (type == "Track") {
-      return handleSubsetColl<edm4hep::TrackCollection>(LCCollection, typeMapping.tracks);
-    }
-    else if (type == "Cluster") {
-      return handleSubsetColl<edm4hep::ClusterCollection>(LCCollection, typeMapping.clusters);
-    }
-    else if (type == "SimCalorimeterHit") {
-      return handleSubsetColl<edm4hep::SimCalorimeterHitCollection>(LCCollection, typeMapping.simCaloHits);
-    }
-    else if (type == "RawCalorimeterHit") {
-      return handleSubsetColl<edm4hep::RawCalorimeterHitCollection>(LCCollection, typeMapping.rawCaloHits);
-    }
-    else if (type == "CalorimeterHit") {
-      return handleSubsetColl<edm4hep::CalorimeterHitCollection>(LCCollection, typeMapping.caloHits);
-    }
-    else if (type == "SimTrackerHit") {
-      return handleSubsetColl<edm4hep::SimTrackerHitCollection>(LCCollection, typeMapping.simTrackerHits);
-    }
-    else if (type == "TPCHit") {
-      return handleSubsetColl<edm4hep::RawTimeSeriesCollection>(LCCollection, typeMapping.tpcHits);
-    }
-    else if (type == "TrackerHit") {
-      return handleSubsetColl<edm4hep::TrackerHitCollection>(LCCollection, typeMapping.trackerHits);
-    }
-    else if (type == "TrackerHitPlane") {
-      return handleSubsetColl<edm4hep::TrackerHitPlaneCollection>(LCCollection, typeMapping.trackerHitPlanes);
-    }
-    else {
-      return nullptr;
+    if (const auto fill = getSubsetConverter<ObjectMappingT>(getLcioTypeId(type))) {
+      return fill(LCCollection, typeMapping);
     }
+    return nullptr;
   }
 
 } // namespace LCIO2EDM4hepConv
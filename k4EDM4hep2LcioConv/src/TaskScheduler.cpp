@@ -0,0 +1,199 @@
+#include "k4EDM4hep2LcioConv/TaskScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace k4EDM4hep2LcioConv {
+
+  namespace {
+    /// The scheduler for which the current thread is a worker (if any) and the
+    /// index of its queue
+    thread_local const TaskScheduler* t_scheduler = nullptr;
+    thread_local std::size_t t_queueIndex = 0;
+    /// The scheduler whose task is currently being run on this thread (if any)
+    thread_local TaskScheduler* t_runningScheduler = nullptr;
+
+    /// Number of unsuccessful attempts to find a task to run after which a
+    /// thread waiting for a TaskGroup goes to sleep
+    constexpr unsigned maxFailedRuns = 64;
+  } // namespace
+
+  TaskScheduler::TaskScheduler(unsigned nThreads)
+  {
+    nThreads = std::max(nThreads, 1u);
+    m_queues.reserve(nThreads);
+    for (unsigned i = 0; i < nThreads; ++i) {
+      m_queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    m_threads.reserve(nThreads);
+    for (unsigned i = 0; i < nThreads; ++i) {
+      m_threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+  }
+
+  TaskScheduler::~TaskScheduler()
+  {
+    {
+      std::lock_guard lock(m_sleepMutex);
+      m_stop = true;
+    }
+    m_wakeUp.notify_all();
+    for (auto& thread : m_threads) {
+      thread.join();
+    }
+  }
+
+  TaskScheduler* TaskScheduler::current() { return t_runningScheduler; }
+
+  std::size_t TaskScheduler::currentQueue() const { return t_scheduler == this ? t_queueIndex : m_queues.size(); }
+
+  void TaskScheduler::spawn(Task task)
+  {
+    auto queue = currentQueue();
+    if (queue == m_queues.size()) {
+      queue = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+    // Count the task before it becomes visible, such that the counter cannot
+    // be decremented by a thread taking the task before it is incremented
+    m_nQueued.fetch_add(1);
+    {
+      std::lock_guard lock(m_queues[queue]->mutex);
+      m_queues[queue]->tasks.push_back(std::move(task));
+    }
+    // Make sure that no worker is between checking for queued tasks and going
+    // to sleep, since it would miss the notification otherwise
+    { std::lock_guard lock(m_sleepMutex); }
+    m_wakeUp.notify_one();
+  }
+
+  void TaskScheduler::notifyAll()
+  {
+    { std::lock_guard lock(m_sleepMutex); }
+    m_wakeUp.notify_all();
+  }
+
+  bool TaskScheduler::popTask(std::size_t queue, Task& task)
+  {
+    auto& workerQueue = *m_queues[queue];
+    std::lock_guard lock(workerQueue.mutex);
+    if (workerQueue.tasks.empty()) {
+      return false;
+    }
+    task = std::move(workerQueue.tasks.back());
+    workerQueue.tasks.pop_back();
+    return true;
+  }
+
+  bool TaskScheduler::stealTask(std::size_t thief, Task& task)
+  {
+    const auto nQueues = m_queues.size();
+    for (std::size_t i = 1; i <= nQueues; ++i) {
+      const auto victim = (thief + i) % nQueues;
+      if (victim == thief) {
+        continue;
+      }
+      auto& workerQueue = *m_queues[victim];
+      std::lock_guard lock(workerQueue.mutex);
+      if (!workerQueue.tasks.empty()) {
+        task = std::move(workerQueue.tasks.front());
+        workerQueue.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool TaskScheduler::runOneTask(std::size_t preferredQueue)
+  {
+    Task task;
+    if ((preferredQueue < m_queues.size() && popTask(preferredQueue, task)) || stealTask(preferredQueue, task)) {
+      m_nQueued.fetch_sub(1);
+      // Tasks can also be run by threads waiting for a TaskGroup, which might
+      // be in the middle of a task of another scheduler. The tasks never throw,
+      // since the TaskGroup catches all exceptions
+      auto* const previous = std::exchange(t_runningScheduler, this);
+      task();
+      t_runningScheduler = previous;
+      return true;
+    }
+    return false;
+  }
+
+  void TaskScheduler::workerLoop(std::size_t index)
+  {
+    t_scheduler = this;
+    t_queueIndex = index;
+    while (true) {
+      if (runOneTask(index)) {
+        continue;
+      }
+      std::unique_lock lock(m_sleepMutex);
+      m_wakeUp.wait(lock, [this]() { return m_stop || m_nQueued.load() > 0; });
+      if (m_stop && m_nQueued.load() == 0) {
+        return;
+      }
+    }
+  }
+
+  TaskScheduler::TaskGroup::~TaskGroup()
+  {
+    try {
+      wait();
+    } catch (...) {
+      // The exception has already been reported if wait was called before
+    }
+  }
+
+  void TaskScheduler::TaskGroup::run(Task task)
+  {
+    m_nPending.fetch_add(1);
+    m_scheduler.spawn([this, &scheduler = m_scheduler, task = std::move(task)]() {
+      try {
+        task();
+      } catch (...) {
+        std::lock_guard lock(m_errorMutex);
+        if (!m_error) {
+          m_error = std::current_exception();
+        }
+      }
+      // Nothing of this group must be touched after this, since a waiting
+      // thread might return and destroy it
+      if (m_nPending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        scheduler.notifyAll();
+      }
+    });
+  }
+
+  void TaskScheduler::TaskGroup::wait()
+  {
+    const auto queue = m_scheduler.currentQueue();
+    unsigned nFailedRuns = 0;
+    while (m_nPending.load(std::memory_order_acquire) > 0) {
+      if (m_scheduler.runOneTask(queue)) {
+        nFailedRuns = 0;
+        continue;
+      }
+      if (++nFailedRuns < maxFailedRuns) {
+        std::this_thread::yield();
+        continue;
+      }
+      // The remaining tasks of this group are running elsewhere, so sleep until
+      // they are done or there are new tasks to help with
+      std::unique_lock lock(m_scheduler.m_sleepMutex);
+      m_scheduler.m_wakeUp.wait(lock, [this]() {
+        return m_nPending.load(std::memory_order_acquire) == 0 || m_scheduler.m_nQueued.load() > 0;
+      });
+      nFailedRuns = 0;
+    }
+
+    std::exception_ptr error;
+    {
+      std::lock_guard lock(m_errorMutex);
+      std::swap(error, m_error);
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+} // namespace k4EDM4hep2LcioConv
@@ -1,6 +1,10 @@
 #include "k4EDM4hep2LcioConv/k4EDM4hep2LcioConv.h"
 #include "EVENT/MCParticle.h"
 
+#include <algorithm>
+#include <bitset>
+#include <tuple>
+
 namespace EDM4hep2LCIOConv {
 
   // The EventHeaderCollection should be of length 1
@@ -17,6 +21,20 @@ namespace EDM4hep2LCIOConv {
     lcio_event->setWeight(header.getWeight());
   }
 
+  lcio::ParticleIDImpl* convParticleID(const edm4hep::ParticleID& edm_pid)
+  {
+    auto* lcio_pid = new lcio::ParticleIDImpl;
+    lcio_pid->setType(edm_pid.getType());
+    lcio_pid->setPDG(edm_pid.getPDG());
+    lcio_pid->setLikelihood(edm_pid.getLikelihood());
+    lcio_pid->setAlgorithmType(edm_pid.getAlgorithmType());
+    for (const auto& param : edm_pid.getParameters()) {
+      lcio_pid->addParameter(param);
+    }
+
+    return lcio_pid;
+  }
+
   // Check if a collection is already in the event by its name
   bool collectionExist(const std::string& collection_name, const lcio::LCEventImpl* lcio_event)
   {
@@ -24,83 +42,168 @@ namespace EDM4hep2LCIOConv {
     return std::find(coll->begin(), coll->end(), collection_name) != coll->end();
   }
 
+  void setCellIDEncoding(lcio::LCCollectionVec* coll, const std::string& cellIDEncoding, int flagBit)
+  {
+    if (cellIDEncoding.empty()) {
+      return;
+    }
+    coll->parameters().setValue(lcio::LCIO::CellIDEncoding, cellIDEncoding);
+    std::bitset<32> flag(coll->getFlag());
+    flag.set(flagBit);
+    coll->setFlag(flag.to_ulong());
+  }
+
+  std::unique_ptr<lcio::LCEventImpl> convEvent(const podio::Frame& edmEvent)
+  {
+    thread_local EventConverter converter {};
+    return converter.convert(edmEvent);
+  }
+
   std::unique_ptr<lcio::LCEventImpl> convEvent(const podio::Frame& edmEvent, const podio::Frame& metadata)
   {
-    auto lcioEvent = std::make_unique<lcio::LCEventImpl>();
-    auto objectMappings = CollectionsPairVectors {};
+    // The metadata does not change during a run, so the CellIDEncodings only
+    // have to be looked up again if a different Frame is passed
+    thread_local EventConverter converter {};
+    if (converter.getMetadata() != &metadata) {
+      converter.setMetadata(metadata);
+    }
+    return converter.convert(edmEvent);
+  }
 
-    const auto& collections = edmEvent.getAvailableCollections();
-    for (const auto& name : collections) {
-      const auto edmCollection = edmEvent.get(name);
+  namespace {
+    template<typename... CollTs>
+    int findConversionRank(std::string_view valueTypeName, std::tuple<CollTs...>*)
+    {
+      int rank = 0;
+      ((valueTypeName == CollTs::valueTypeName && (rank = EdmTypeTraits<CollTs>::conversionRank, true)) || ...);
+      return rank;
+    }
+  } // namespace
 
-      const auto& cellIDStr = metadata.getParameter<std::string>(podio::collMetadataParamName(name, "CellIDEncoding"));
+  int getConversionRank(std::string_view valueTypeName)
+  {
+    return findConversionRank(valueTypeName, static_cast<KnownEdmCollectionTypes*>(nullptr));
+  }
 
-      if (auto coll = dynamic_cast<const edm4hep::TrackCollection*>(edmCollection)) {
-        auto lcColl = convTracks(coll, objectMappings.tracks, objectMappings.trackerHits);
-        lcioEvent->addCollection(lcColl, name);
-      }
-      else if (auto coll = dynamic_cast<const edm4hep::TrackerHitCollection*>(edmCollection)) {
-        auto lcColl = convTrackerHits(coll, cellIDStr, objectMappings.trackerHits);
-        lcioEvent->addCollection(lcColl, name);
-      }
-      else if (auto coll = dynamic_cast<const edm4hep::SimTrackerHitCollection*>(edmCollection)) {
-        auto lcColl = convSimTrackerHits(coll, cellIDStr, objectMappings.simTrackerHits, objectMappings.mcParticles);
-        lcioEvent->addCollection(lcColl, name);
-      }
-      else if (auto coll = dynamic_cast<const edm4hep::CalorimeterHitCollection*>(edmCollection)) {
-        auto lcColl = convCalorimeterHits(coll, cellIDStr, objectMappings.caloHits);
-        lcioEvent->addCollection(lcColl, name);
-      }
-      else if (auto coll = dynamic_cast<const edm4hep::RawCalorimeterHitCollection*>(edmCollection)) {
-        auto lcColl = convRawCalorimeterHits(coll, objectMappings.rawCaloHits);
-        lcioEvent->addCollection(lcColl, name);
-      }
-      else if (auto coll = dynamic_cast<const edm4hep::SimCalorimeterHitCollection*>(edmCollection)) {
-        auto lcColl = convSimCalorimeterHits(coll, cellIDStr, objectMappings.simCaloHits, objectMappings.mcParticles);
-        lcioEvent->addCollection(lcColl, name);
+  EventConverter::EventConverter(const podio::Frame& metadata) : m_metadata(&metadata) {}
+
+  void EventConverter::setMetadata(const podio::Frame& metadata)
+  {
+    m_metadata = &metadata;
+    for (auto& [name, entry] : m_dispatchPlan) {
+      entry.hasCellIDEncoding = false;
+    }
+  }
+
+  void EventConverter::reset()
+  {
+    m_objectMappings.forEachMap([](const char*, auto& map) { map.clear(); });
+  }
+
+  const EventConverter::DispatchEntry& EventConverter::getDispatchEntry(
+    const std::string& name,
+    const podio::CollectionBase* coll)
+  {
+    const auto valueTypeName = coll->getValueTypeName();
+    auto& entry = m_dispatchPlan[name];
+    if (entry.valueTypeName != valueTypeName) {
+      entry.valueTypeName = std::string(valueTypeName);
+      entry.convert = getCollectionConverter<CollectionsPairVectors>(valueTypeName);
+      entry.conversionRank = getConversionRank(valueTypeName);
+      entry.fillSubset = getSubsetConverter<CollectionsPairVectors>(valueTypeName);
+      entry.hasCellIDEncoding = false;
+      if (entry.convert == nullptr) {
+        std::cerr << "Error trying to convert requested " << valueTypeName << " with name " << name << "\n"
+                  << "List of supported types: "
+                  << "Track, TrackerHit, SimTrackerHit, "
+                  << "Cluster, CalorimeterHit, RawCalorimeterHit, "
+                  << "SimCalorimeterHit, Vertex, ReconstructedParticle, "
+                  << "MCParticle." << std::endl;
       }
-      else if (auto coll = dynamic_cast<const edm4hep::RawTimeSeriesCollection*>(edmCollection)) {
-        auto lcColl = convTPCHits(coll, objectMappings.tpcHits);
-        lcioEvent->addCollection(lcColl, name);
+    }
+    if (!entry.hasCellIDEncoding) {
+      entry.cellIDEncoding.clear();
+      if (m_metadata != nullptr) {
+        entry.cellIDEncoding =
+          m_metadata->getParameter<std::string>(podio::collMetadataParamName(name, "CellIDEncoding"));
       }
-      else if (auto coll = dynamic_cast<const edm4hep::ClusterCollection*>(edmCollection)) {
-        auto lcColl = convClusters(coll, objectMappings.clusters, objectMappings.caloHits);
-        lcioEvent->addCollection(lcColl, name);
+      entry.hasCellIDEncoding = true;
+    }
+    return entry;
+  }
+
+  std::unique_ptr<lcio::LCEventImpl> EventConverter::convert(const podio::Frame& edmEvent)
+  {
+    // Make sure there is nothing left over from a previous event (e.g. in case
+    // of an exception)
+    reset();
+    m_objectMappings.forEachMap([this](const char* name, auto& map) { m_capacityPlanner.reserve(name, map); });
+
+    auto lcioEvent = std::make_unique<lcio::LCEventImpl>();
+
+    // Convert the collections in the order of their dependencies, such that
+    // the objects they point to have already been converted and all relations
+    // can be set directly during the conversion. Subset collections are
+    // handled at the very end, once all the objects they point to are
+    // available
+    std::vector<std::tuple<const DispatchEntry*, std::string, const podio::CollectionBase*>> conversionOrder;
+    std::vector<std::tuple<const DispatchEntry*, std::string, const podio::CollectionBase*>> subsetCollections;
+    for (auto& name : edmEvent.getAvailableCollections()) {
+      const auto edmCollection = edmEvent.get(name);
+      const auto& dispatch = getDispatchEntry(name, edmCollection);
+      if (dispatch.convert == nullptr) {
+        continue;
       }
-      else if (auto coll = dynamic_cast<const edm4hep::VertexCollection*>(edmCollection)) {
-        auto lcColl = convVertices(coll, objectMappings.vertices, objectMappings.recoParticles);
-        lcioEvent->addCollection(lcColl, name);
+      if (edmCollection->isSubsetCollection()) {
+        subsetCollections.emplace_back(&dispatch, std::move(name), edmCollection);
       }
-      else if (auto coll = dynamic_cast<const edm4hep::MCParticleCollection*>(edmCollection)) {
-        auto lcColl = convMCParticles(coll, objectMappings.mcParticles);
-        lcioEvent->addCollection(lcColl, name);
+      else {
+        conversionOrder.emplace_back(&dispatch, std::move(name), edmCollection);
       }
-      else if (auto coll = dynamic_cast<const edm4hep::ReconstructedParticleCollection*>(edmCollection)) {
-        auto lcColl = convReconstructedParticles(
-          coll, objectMappings.recoParticles, objectMappings.tracks, objectMappings.vertices, objectMappings.clusters);
+    }
+    std::stable_sort(conversionOrder.begin(), conversionOrder.end(), [](const auto& lhs, const auto& rhs) {
+      return std::get<0>(lhs)->conversionRank < std::get<0>(rhs)->conversionRank;
+    });
+
+    for (const auto& [dispatch, name, edmCollection] : conversionOrder) {
+      if (auto lcColl = dispatch->convert(edmCollection, dispatch->cellIDEncoding, m_objectMappings, lcioEvent.get())) {
         lcioEvent->addCollection(lcColl, name);
       }
-      else if (auto coll = dynamic_cast<const edm4hep::EventHeaderCollection*>(edmCollection)) {
-        convEventHeader(coll, lcioEvent.get());
-      }
-      else if (auto coll = dynamic_cast<const edm4hep::CaloHitContributionCollection*>(edmCollection)) {
-        // "converted" as part of FillMissingCollectoins at the end
+    }
+
+    // Vertices and ReconstructedParticles point to each other, so the start
+    // vertices can only be linked once both have been converted. The
+    // CaloHitContributions are added once all MCParticles are available.
+    linkStartVertices(m_objectMappings.recoParticles, m_objectMappings.vertices);
+    convCaloHitContributions(m_objectMappings.simCaloHits, m_objectMappings.mcParticles);
+
+    // The subset collections point to the already converted LCIO objects
+    for (const auto& [dispatch, name, edmCollection] : subsetCollections) {
+      if (dispatch->fillSubset == nullptr) {
         continue;
       }
-      else {
-        std::cerr << "Error trying to convert requested " << edmCollection->getValueTypeName() << " with name " << name
-                  << "\n"
-                  << "List of supported types: "
-                  << "Track, TrackerHit, SimTrackerHit, "
-                  << "Cluster, CalorimeterHit, RawCalorimeterHit, "
-                  << "SimCalorimeterHit, Vertex, ReconstructedParticle, "
-                  << "MCParticle." << std::endl;
-      }
+      lcioEvent->addCollection(dispatch->fillSubset(edmCollection, m_objectMappings), name);
     }
 
-    FillMissingCollections(objectMappings);
+    m_objectMappings.forEachMap([this](const char* name, auto& map) { m_capacityPlanner.record(name, map.size()); });
+    m_capacityPlanner.endEvent();
+    reset();
 
     return lcioEvent;
   }
 
+  // Explicit instantiations for the default CollectionsPairVectors (declared
+  // extern in the header)
+  template void FillMissingCollections(CollectionsPairVectors&);
+  template void FillMissingCollections(CollectionsPairVectors&, const CollectionsPairVectors&);
+  template CollectionConverterT<CollectionsPairVectors>
+  getCollectionConverter<CollectionsPairVectors>(std::string_view);
+  template SubsetConverterT<CollectionsPairVectors> getSubsetConverter<CollectionsPairVectors>(std::string_view);
+  template void linkStartVertices(
+    decltype(CollectionsPairVectors::recoParticles)&,
+    const decltype(CollectionsPairVectors::vertices)&);
+  template void convCaloHitContributions(
+    decltype(CollectionsPairVectors::simCaloHits)&,
+    const decltype(CollectionsPairVectors::mcParticles)&);
+
 } // namespace EDM4hep2LCIOConv
@@ -1,49 +1,66 @@
 #include "k4EDM4hep2LcioConv/k4Lcio2EDM4hepConv.h"
 
 #include <iostream>
+#include <unordered_map>
 
 namespace LCIO2EDM4hepConv {
 
   edm4hep::TrackState convertTrackState(const EVENT::TrackState* trackState)
   {
-    auto edmtrackState = edm4hep::TrackState {};
-    edmtrackState.location = trackState->getLocation();
-    edmtrackState.D0 = trackState->getD0();
-    edmtrackState.phi = trackState->getPhi();
-    edmtrackState.omega = trackState->getOmega();
-    edmtrackState.Z0 = trackState->getZ0();
-    edmtrackState.tanLambda = trackState->getTanLambda();
-    // not available in lcio
-    edmtrackState.time = -1;
-    const auto refPoint = trackState->getReferencePoint();
-    edmtrackState.referencePoint = Vector3fFrom({refPoint[0], refPoint[1], refPoint[2]});
-    const auto& covMatrix = trackState->getCovMatrix();
-    edmtrackState.covMatrix = {
-      covMatrix[0],
-      covMatrix[1],
-      covMatrix[2],
-      covMatrix[3],
-      covMatrix[4],
-      covMatrix[5],
-      covMatrix[6],
-      covMatrix[7],
-      covMatrix[8],
-      covMatrix[9],
-      covMatrix[10],
-      covMatrix[11],
-      covMatrix[12],
-      covMatrix[13],
-      covMatrix[14],
-      0,
-      0,
-      0,
-      0,
-      0,
-      0};
-
-    return edmtrackState;
+    return detail::convertTrackState(trackState);
   }
 
+  void convertTrackStates(const EVENT::TrackStateVec& trackStates, std::vector<edm4hep::TrackState>& edmTrackStates)
+  {
+    edmTrackStates.reserve(edmTrackStates.size() + trackStates.size());
+    detail::forEachElement<EVENT::TrackState, IOIMPL::TrackStateIOImpl, IMPL::TrackStateImpl>(
+      trackStates,
+      [&edmTrackStates](EVENT::TrackState*, const auto* trackState) {
+        edmTrackStates.push_back(detail::convertTrackState(trackState));
+      });
+  }
+
+  namespace detail {
+    void CaloHitContributionArrays::allocate(const std::vector<EVENT::SimCalorimeterHit*>& hits)
+    {
+      offsets.resize(hits.size() + 1);
+      offsets[0] = 0;
+      forEachElement<EVENT::SimCalorimeterHit, IOIMPL::SimCalorimeterHitIOImpl, IMPL::SimCalorimeterHitImpl>(
+        hits,
+        [this, i = std::size_t {0}](EVENT::SimCalorimeterHit*, const auto* hit) mutable {
+          offsets[i + 1] = offsets[i] + k4EDM4hep2LcioConv::detail::lcio_getters::getNMCParticles::get(hit);
+          ++i;
+        });
+
+      const auto nContributions = offsets.back();
+      PDG.resize(nContributions);
+      energy.resize(nContributions);
+      time.resize(nContributions);
+      stepPosition.resize(nContributions);
+      particle.resize(nContributions);
+    }
+
+    void CaloHitContributionArrays::fill(const std::vector<EVENT::SimCalorimeterHit*>& hits)
+    {
+      namespace getters = k4EDM4hep2LcioConv::detail::lcio_getters;
+
+      forEachElement<EVENT::SimCalorimeterHit, IOIMPL::SimCalorimeterHitIOImpl, IMPL::SimCalorimeterHitImpl>(
+        hits,
+        [this, iHit = std::size_t {0}](EVENT::SimCalorimeterHit*, const auto* hit) mutable {
+          const auto begin = offsets[iHit];
+          const int nContributions = offsets[iHit + 1] - begin;
+          for (int j = 0; j < nContributions; ++j) {
+            PDG[begin + j] = getters::getPDGCont::get(hit, j);
+            energy[begin + j] = getters::getEnergyCont::get(hit, j);
+            time[begin + j] = getters::getTimeCont::get(hit, j);
+            stepPosition[begin + j] = edm4hep::Vector3f(getters::getStepPosition::get(hit, j));
+            particle[begin + j] = getters::getParticleCont::get(hit, j);
+          }
+          ++iHit;
+        });
+    }
+  } // namespace detail
+
   edm4hep::MutableParticleID convertParticleID(const EVENT::ParticleID* pid)
   {
     auto result = edm4hep::MutableParticleID {};
@@ -71,11 +88,146 @@ namespace LCIO2EDM4hepConv {
     return headerColl;
   }
 
+  namespace {
+    template<std::size_t... Ids>
+    std::unordered_map<std::string_view, LcioTypeId> makeLcioTypeIds(std::index_sequence<Ids...>)
+    {
+      return {{LcioTypeTraits<static_cast<LcioTypeId>(Ids)>::typeName, static_cast<LcioTypeId>(Ids)}...};
+    }
+  } // namespace
+
+  LcioTypeId getLcioTypeId(const std::string& typeName)
+  {
+    static const auto typeIds = makeLcioTypeIds(std::make_index_sequence<detail::NLcioTypeIds> {});
+    if (const auto it = typeIds.find(typeName); it != typeIds.end()) {
+      return it->second;
+    }
+    return LcioTypeId::Unknown;
+  }
+
+  void LcioEdmTypeMapping::clear()
+  {
+    forEachMap([](const char*, auto& map) { map.clear(); });
+  }
+
+  namespace {
+    template<typename MapT>
+    void mergeMap(MapT& into, const MapT& from)
+    {
+      if (from.empty()) {
+        return;
+      }
+      k4EDM4hep2LcioConv::detail::mapReserve(into, from.size());
+      for (const auto& [lcio, edm] : from) {
+        k4EDM4hep2LcioConv::detail::mapInsert(lcio, edm, into);
+      }
+    }
+  } // namespace
+
+  void LcioEdmTypeMapping::merge(const LcioEdmTypeMapping& other)
+  {
+    mergeMap(tracks, other.tracks);
+    mergeMap(trackerHits, other.trackerHits);
+    mergeMap(simTrackerHits, other.simTrackerHits);
+    mergeMap(caloHits, other.caloHits);
+    mergeMap(rawCaloHits, other.rawCaloHits);
+    mergeMap(simCaloHits, other.simCaloHits);
+    mergeMap(tpcHits, other.tpcHits);
+    mergeMap(clusters, other.clusters);
+    mergeMap(vertices, other.vertices);
+    mergeMap(recoParticles, other.recoParticles);
+    mergeMap(mcParticles, other.mcParticles);
+    mergeMap(trackerHitPlanes, other.trackerHitPlanes);
+    mergeMap(particleIDs, other.particleIDs);
+  }
+
   podio::Frame convertEvent(EVENT::LCEvent* evt, const std::vector<std::string>& collsToConvert)
   {
-    auto typeMapping = LcioEdmTypeMapping {};
-    std::vector<CollNamePair> edmevent;
-    std::vector<std::pair<std::string, EVENT::LCCollection*>> LCRelations;
+    return EventConverter {}.convert(evt, collsToConvert);
+  }
+
+  void EventConverter::reset()
+  {
+    // Clear the mappings first, since they hold handles to objects that are
+    // owned by the collections
+    m_typeMapping.clear();
+    m_edmEvent.clear();
+    m_lcRelations.clear();
+    m_conversions.clear();
+    m_subsets.clear();
+    m_tasks.clear();
+  }
+
+  void EventConverter::runTasks(std::vector<std::function<void()>>& tasks)
+  {
+    if (m_scheduler == nullptr) {
+      for (auto& task : tasks) {
+        task();
+      }
+    }
+    else {
+      k4EDM4hep2LcioConv::TaskScheduler::TaskGroup group(*m_scheduler);
+      for (auto& task : tasks) {
+        group.run(std::move(task));
+      }
+      group.wait();
+    }
+    tasks.clear();
+  }
+
+  const EventConverter::DispatchEntry&
+  EventConverter::getDispatchEntry(const std::string& name, const std::string& typeName)
+  {
+    auto& entry = m_dispatchPlan[name];
+    if (entry.typeName != typeName) {
+      entry.typeName = typeName;
+      entry.typeId = getLcioTypeId(typeName);
+      entry.convert = getCollectionConverter<LcioEdmTypeMapping>(entry.typeId);
+      entry.fillSubset = getSubsetConverter<LcioEdmTypeMapping>(entry.typeId);
+    }
+    return entry;
+  }
+
+  std::vector<CollNamePair> EventConverter::createAssociations()
+  {
+    std::vector<CollNamePair> assoCollVec;
+    for (const auto& [name, relations] : m_lcRelations) {
+      const auto& params = relations->getParameters();
+
+      const auto& fromType = params.getStringVal("FromType");
+      const auto& toType = params.getStringVal("ToType");
+      if (fromType.empty() || toType.empty()) {
+        std::cerr << "LCRelation collection " << name << " has missing FromType or ToType parameters. "
+                  << "Cannot convert it without this information." << std::endl;
+        continue;
+      }
+
+      auto& entry = m_associationPlan[name];
+      if (entry.fromType != fromType || entry.toType != toType) {
+        entry.fromType = fromType;
+        entry.toType = toType;
+        entry.convert =
+          getAssociationConverter<LcioEdmTypeMapping>(getLcioTypeId(fromType), getLcioTypeId(toType));
+      }
+
+      if (entry.convert != nullptr) {
+        assoCollVec.emplace_back(name, entry.convert(relations, m_typeMapping));
+      }
+      else {
+        std::cout << "Relation from: " << fromType << " to: " << toType << " (" << name
+                  << ") is not beeing handled during creation of associations" << std::endl;
+      }
+    }
+
+    return assoCollVec;
+  }
+
+  podio::Frame EventConverter::convert(EVENT::LCEvent* evt, const std::vector<std::string>& collsToConvert)
+  {
+    // Make sure there is nothing left over from a previous event (e.g. in case
+    // of an exception)
+    reset();
+    m_typeMapping.forEachMap([this](const char* name, auto& map) { m_capacityPlanner.reserve(name, map); });
 
     const auto& lcioNames = [&collsToConvert, &evt]() {
       if (collsToConvert.empty()) {
@@ -84,40 +236,79 @@ namespace LCIO2EDM4hepConv {
       return collsToConvert;
     }();
 
-    // In this loop the data gets converted.
+    // Collect the collections that have to be converted
     for (const auto& lcioname : lcioNames) {
       const auto& lcioColl = evt->getCollection(lcioname);
-      const auto& lciotype = lcioColl->getTypeName();
-      if (lciotype == "LCRelation") {
-        LCRelations.push_back(std::make_pair(lcioname, lcioColl));
+      const auto& dispatch = getDispatchEntry(lcioname, lcioColl->getTypeName());
+      if (dispatch.typeId == LcioTypeId::LCRelation) {
+        m_lcRelations.push_back(std::make_pair(lcioname, lcioColl));
         // We handle Relations (aka Associations) once we have converted all the
         // data parts.
         continue;
       }
 
-      if (!lcioColl->isSubset()) {
-        for (auto&& [name, edmColl] : convertCollection(lcioname, lcioColl, typeMapping)) {
-          if (edmColl != nullptr) {
-            edmevent.emplace_back(std::move(name), std::move(edmColl));
-          }
+      if (lcioColl->isSubset()) {
+        if (dispatch.fillSubset != nullptr) {
+          m_subsets.push_back({&lcioname, lcioColl, dispatch.fillSubset, nullptr});
         }
+        continue;
       }
+      if (dispatch.convert == nullptr) {
+        std::cerr << dispatch.typeName << " is a collection type for which no known conversion exists." << std::endl;
+        continue;
+      }
+      m_conversions.push_back({&lcioname, lcioColl, dispatch.convert, {}});
     }
-    // Filling of the Subset Colections
-    for (const auto& lcioname : lcioNames) {
 
-      auto lcioColl = evt->getCollection(lcioname);
-      if (lcioColl->isSubset()) {
-        const auto& lciotype = lcioColl->getTypeName();
-        auto edmColl = fillSubset(lcioColl, typeMapping, lciotype);
+    // Converting the data. With a scheduler every collection gets its own
+    // mapping shard, which are merged afterwards
+    if (m_scheduler != nullptr && m_mappingShards.size() < m_conversions.size()) {
+      m_mappingShards.resize(m_conversions.size());
+    }
+    for (std::size_t i = 0; i < m_conversions.size(); ++i) {
+      m_tasks.emplace_back([this, i]() {
+        auto& conversion = m_conversions[i];
+        auto& mapping = m_scheduler != nullptr ? m_mappingShards[i] : m_typeMapping;
+        conversion.result = conversion.convert(*conversion.name, conversion.coll, mapping);
+      });
+    }
+    runTasks(m_tasks);
+    for (std::size_t i = 0; i < m_conversions.size(); ++i) {
+      if (m_scheduler != nullptr) {
+        m_typeMapping.merge(m_mappingShards[i]);
+        m_mappingShards[i].clear();
+      }
+      for (auto&& [name, edmColl] : m_conversions[i].result) {
         if (edmColl != nullptr) {
-          edmevent.emplace_back(lcioname, std::move(edmColl));
+          m_edmEvent.emplace_back(std::move(name), std::move(edmColl));
         }
       }
     }
-    // Filling all the OneToMany and OneToOne Relations and creating the AssociationCollections.
-    resolveRelations(typeMapping);
-    auto assoCollVec = createAssociations(typeMapping, LCRelations);
+
+    // Filling of the Subset Colections, all the OneToMany and OneToOne
+    // Relations and creating the AssociationCollections and
+    // CaloHitContributions. These only depend on the converted data.
+    for (auto& subset : m_subsets) {
+      m_tasks.emplace_back([this, &subset]() { subset.result = subset.fillSubset(subset.coll, m_typeMapping); });
+    }
+    forEachRelationResolver(m_typeMapping, m_typeMapping, [this](auto&& resolve) { m_tasks.emplace_back(resolve); });
+    std::vector<CollNamePair> assoCollVec;
+    m_tasks.emplace_back([this, &assoCollVec]() { assoCollVec = createAssociations(); });
+    // only create CaloHitContributions if necessary (i.e. if we have converted
+    // SimCalorimeterHits)
+    std::unique_ptr<edm4hep::CaloHitContributionCollection> calocontr;
+    if (not m_typeMapping.simCaloHits.empty()) {
+      m_tasks.emplace_back([this, &calocontr]() {
+        calocontr = createCaloHitContributions(m_typeMapping.simCaloHits, m_typeMapping.mcParticles);
+      });
+    }
+    runTasks(m_tasks);
+    for (auto& subset : m_subsets) {
+      if (subset.result != nullptr) {
+        m_edmEvent.emplace_back(*subset.name, std::move(subset.result));
+      }
+    }
+
     auto headerColl = createEventHeader(evt);
 
     // Now everything is done and we simply populate a Frame
@@ -125,19 +316,20 @@ namespace LCIO2EDM4hepConv {
     // convert put the event parameters into the frame
     convertObjectParameters<EVENT::LCEvent>(evt, event);
 
-    // only create CaloHitContributions if necessary (i.e. if we have converted
-    // SimCalorimeterHits)
-    if (not typeMapping.simCaloHits.empty()) {
-      auto calocontr = createCaloHitContributions(typeMapping.simCaloHits, typeMapping.mcParticles);
+    if (calocontr != nullptr) {
       event.put(std::move(calocontr), "AllCaloHitContributionsCombined");
     }
     event.put(std::move(headerColl), "EventHeader");
-    for (auto& [name, coll] : edmevent) {
+    for (auto& [name, coll] : m_edmEvent) {
       event.put(std::move(coll), name);
     }
     for (auto& [name, coll] : assoCollVec) {
       event.put(std::move(coll), name);
     }
+
+    m_typeMapping.forEachMap([this](const char* name, auto& map) { m_capacityPlanner.record(name, map.size()); });
+    m_capacityPlanner.endEvent();
+    reset();
     return event;
   }
 
@@ -156,4 +348,25 @@ namespace LCIO2EDM4hepConv {
     return runHeaderFrame;
   }
 
+  // Explicit instantiations for the default LcioEdmTypeMapping (declared extern
+  // in the header)
+  template std::vector<CollNamePair> convertCollection(const std::string&, EVENT::LCCollection*, LcioEdmTypeMapping&);
+  template void resolveRelations(LcioEdmTypeMapping&);
+  template void resolveRelations(LcioEdmTypeMapping&, const LcioEdmTypeMapping&);
+  template void resolveRelations(LcioEdmTypeMapping&, k4EDM4hep2LcioConv::TaskScheduler&);
+  template void resolveRelations(LcioEdmTypeMapping&, const LcioEdmTypeMapping&, k4EDM4hep2LcioConv::TaskScheduler&);
+  template std::vector<CollNamePair>
+  createAssociations(const LcioEdmTypeMapping&, const std::vector<std::pair<std::string, EVENT::LCCollection*>>&);
+  template std::unique_ptr<podio::CollectionBase>
+  fillSubset(EVENT::LCCollection*, const LcioEdmTypeMapping&, const std::string&);
+  template CollectionConverterT<LcioEdmTypeMapping> getCollectionConverter<LcioEdmTypeMapping>(LcioTypeId);
+  template SubsetConverterT<LcioEdmTypeMapping> getSubsetConverter<LcioEdmTypeMapping>(LcioTypeId);
+  template AssociationConverterT<LcioEdmTypeMapping>
+  getAssociationConverter<LcioEdmTypeMapping>(LcioTypeId, LcioTypeId);
+  template std::unique_ptr<edm4hep::CaloHitContributionCollection> createCaloHitContributions(
+    decltype(LcioEdmTypeMapping::simCaloHits)&,
+    const decltype(LcioEdmTypeMapping::mcParticles)&);
+  template void convertObjectParameters(EVENT::LCEvent*, podio::Frame&);
+  template void convertObjectParameters(EVENT::LCRunHeader*, podio::Frame&);
+
 } // namespace LCIO2EDM4hepConv
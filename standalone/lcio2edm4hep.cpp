@@ -1,15 +1,20 @@
 #include "k4EDM4hep2LcioConv/k4Lcio2EDM4hepConv.h"
 
-#include <IO/LCReader.h>
-#include <IOIMPL/LCFactory.h>
+#include <MT/LCReader.h>
 #include <UTIL/CheckCollections.h>
 
 #include "podio/ROOTFrameWriter.h"
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <utility>
 #include <cstdlib>
@@ -39,7 +44,7 @@ std::vector<std::pair<std::string, std::string>> getNamesAndTypes(const std::str
   return names_types;
 }
 
-constexpr auto usageMsg = R"(usage: lcio2edm4hep [-h] inputfile outputfile [colltypefile] [-n N])";
+constexpr auto usageMsg = R"(usage: lcio2edm4hep [-h] inputfile outputfile [colltypefile] [-n N] [-j N])";
 
 constexpr auto helpMsg = R"(
 Convert an LCIO file to EDM4hep
@@ -53,6 +58,8 @@ positional arguments:
 optional arguments:
   -h, --help        show this help message and exit
   -n N              Limit the number of events to convert to N (default = -1, all events)
+  -j N              Convert the events using N threads (default = 1). The
+                    events are still written in the same order as they are read
 
 Examples:
 - print this message:
@@ -62,6 +69,8 @@ lcio2edm4hep infile.slcio outfile_edm4hep.root
 - the same but providing complete set of collections (either to patch collections in,
   or to only convert a subset):
 lcio2edm4hep infile.slcio outfile_edm4hep.root coltype.txt
+- convert complete file using 8 threads for the conversion:
+lcio2edm4hep infile.slcio outfile_edm4hep.root -j 8
 )";
 
 struct ParsedArgs {
@@ -69,6 +78,7 @@ struct ParsedArgs {
   std::string outputFile {};
   std::string patchFile {};
   int nEvents {-1};
+  int nThreads {1};
 };
 
 void printUsageAndExit()
@@ -77,6 +87,29 @@ void printUsageAndExit()
   std::exit(1);
 }
 
+/// Parse the integer value of an option (e.g. -n N) and remove the option and
+/// its value from argv. Leaves value untouched if the option is not present
+void parseIntOption(std::vector<std::string>& argv, const std::string& option, int& value)
+{
+  auto optionIt = std::find(argv.begin(), argv.end(), option);
+  if (optionIt == argv.end()) {
+    return;
+  }
+  const auto index = std::distance(argv.begin(), optionIt);
+  if (index > argv.size() - 2) {
+    // No argument left to parse
+    printUsageAndExit();
+  }
+  const auto& valueStr = argv[index + 1]; // get the actual value
+  try {
+    value = std::stoi(valueStr);
+  } catch (std::invalid_argument& err) {
+    std::cerr << "Cannot parse " << valueStr << " as an integer" << std::endl;
+    printUsageAndExit();
+  }
+  argv.erase(optionIt, optionIt + 2);
+}
+
 ParsedArgs parseArgs(std::vector<std::string> argv)
 {
   // find help
@@ -88,30 +121,20 @@ ParsedArgs parseArgs(std::vector<std::string> argv)
   }
 
   auto argc = argv.size();
-  if (argc < 3 || argc > 7) {
+  if (argc < 3 || argc > 8) {
     printUsageAndExit();
   }
 
   ParsedArgs args;
-  auto nEventIt = std::find(argv.begin(), argv.end(), "-n");
-  if (nEventIt != argv.end()) {
-    const auto index = std::distance(argv.begin(), nEventIt);
-    if (index > argc - 2) {
-      // No argument left to parse
-      printUsageAndExit();
-    }
-    const auto& value = argv[index + 1]; // get the actual value
-    try {
-      args.nEvents = std::stoi(value);
-    } catch (std::invalid_argument& err) {
-      std::cerr << "Cannot parse " << value << " as an integer" << std::endl;
-      printUsageAndExit();
-    }
-    argv.erase(nEventIt, nEventIt + 2);
+  parseIntOption(argv, "-n", args.nEvents);
+  parseIntOption(argv, "-j", args.nThreads);
+  if (args.nThreads < 1) {
+    std::cerr << "The number of threads has to be at least 1" << std::endl;
+    printUsageAndExit();
   }
 
   argc = argv.size();
-  if (argc < 3) {
+  if (argc < 3 || argc > 4) {
     printUsageAndExit();
   }
   args.inputFile = argv[1];
@@ -122,6 +145,118 @@ ParsedArgs parseArgs(std::vector<std::string> argv)
   return args;
 }
 
+/**
+ * Convert nEvents events using nThreads threads for the conversion. One thread
+ * reads (and patches) the events, the workers convert them with one
+ * EventConverter each and the calling thread writes the converted events in
+ * the order in which they have been read. At most maxInFlight events are read
+ * but not yet written, to bound the memory usage.
+ */
+void convertEventsParallel(
+  MT::LCReader& lcreader,
+  int nEvents,
+  int nThreads,
+  const UTIL::CheckCollections* colPatcher,
+  const std::vector<std::string>& collsToConvert,
+  podio::ROOTFrameWriter& writer)
+{
+  const int maxInFlight = 2 * nThreads;
+
+  std::mutex mutex;
+  std::condition_variable readCond;    // signals that an event has been written
+  std::condition_variable convertCond; // signals that an event has been read
+  std::condition_variable writeCond;   // signals that an event has been converted
+  std::deque<std::pair<int, std::unique_ptr<EVENT::LCEvent>>> toConvert;
+  std::map<int, podio::Frame> converted;
+  int nInFlight = 0;
+  int nRead = 0;
+  bool readingDone = false;
+
+  std::thread reader([&]() {
+    for (int i = 0; i < nEvents; ++i) {
+      {
+        std::unique_lock lock(mutex);
+        readCond.wait(lock, [&]() { return nInFlight < maxInFlight; });
+      }
+      auto evt = lcreader.readNextEvent();
+      if (!evt) {
+        break;
+      }
+      // Patching the Event to make sure all events contain the same Collections.
+      if (colPatcher) {
+        colPatcher->patchCollections(evt.get());
+      }
+      {
+        std::lock_guard lock(mutex);
+        toConvert.emplace_back(i, std::move(evt));
+        ++nInFlight;
+        ++nRead;
+      }
+      convertCond.notify_one();
+    }
+    {
+      std::lock_guard lock(mutex);
+      readingDone = true;
+    }
+    convertCond.notify_all();
+    writeCond.notify_one();
+  });
+
+  std::vector<std::thread> workers;
+  workers.reserve(nThreads);
+  for (int t = 0; t < nThreads; ++t) {
+    workers.emplace_back([&]() {
+      LCIO2EDM4hepConv::EventConverter converter {};
+      std::unique_lock lock(mutex);
+      while (true) {
+        convertCond.wait(lock, [&]() { return !toConvert.empty() || readingDone; });
+        if (toConvert.empty()) {
+          return;
+        }
+        auto [index, evt] = std::move(toConvert.front());
+        toConvert.pop_front();
+        lock.unlock();
+
+        auto edmEvent = converter.convert(evt.get(), collsToConvert);
+        evt.reset();
+
+        lock.lock();
+        converted.emplace(index, std::move(edmEvent));
+        writeCond.notify_one();
+      }
+    });
+  }
+
+  // Write the events in the order in which they have been read
+  for (int next = 0;; ++next) {
+    std::unique_lock lock(mutex);
+    writeCond.wait(lock, [&]() {
+      return (!converted.empty() && converted.begin()->first == next) || (readingDone && next == nRead);
+    });
+    if (converted.empty() || converted.begin()->first != next) {
+      break;
+    }
+    auto edmEvent = std::move(converted.begin()->second);
+    converted.erase(converted.begin());
+    lock.unlock();
+
+    if (next % 10 == 0) {
+      std::cout << "processing Event: " << next << std::endl;
+    }
+    writer.writeFrame(edmEvent, "events");
+
+    lock.lock();
+    --nInFlight;
+    lock.unlock();
+    readCond.notify_one();
+  }
+
+  reader.join();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
 int main(int argc, char* argv[])
 {
   const auto args = parseArgs({argv, argv + argc});
@@ -151,35 +286,41 @@ int main(int argc, char* argv[])
     return names;
   }();
 
-  auto lcreader = IOIMPL::LCFactory::getInstance()->createLCReader();
-  lcreader->open(args.inputFile);
-  std::cout << "Number of events in file: " << lcreader->getNumberOfEvents() << '\n';
-  std::cout << "Number of runs in file: " << lcreader->getNumberOfRuns() << '\n';
+  MT::LCReader lcreader(MT::LCReader::directAccess);
+  lcreader.open(args.inputFile);
+  std::cout << "Number of events in file: " << lcreader.getNumberOfEvents() << '\n';
+  std::cout << "Number of runs in file: " << lcreader.getNumberOfRuns() << '\n';
 
   podio::ROOTFrameWriter writer(args.outputFile);
 
-  for (auto j = 0u; j < lcreader->getNumberOfRuns(); ++j) {
+  for (auto j = 0u; j < lcreader.getNumberOfRuns(); ++j) {
     if (j % 1 == 0) {
       std::cout << "processing RunHeader: " << j << std::endl;
     }
-    auto rhead = lcreader->readNextRunHeader();
+    auto rhead = lcreader.readNextRunHeader();
 
-    const auto edmRunHeader = LCIO2EDM4hepConv::convertRunHeader(rhead);
+    const auto edmRunHeader = LCIO2EDM4hepConv::convertRunHeader(rhead.get());
     writer.writeFrame(edmRunHeader, "runs");
   }
 
-  const int nEvt = args.nEvents > 0 ? args.nEvents : lcreader->getNumberOfEvents();
-  for (auto i = 0u; i < nEvt; ++i) {
-    if (i % 10 == 0) {
-      std::cout << "processing Event: " << i << std::endl;
-    }
-    auto evt = lcreader->readNextEvent();
-    // Patching the Event to make sure all events contain the same Collections.
-    if (patching == true) {
-      colPatcher.patchCollections(evt);
+  const int nEvt = args.nEvents > 0 ? args.nEvents : lcreader.getNumberOfEvents();
+  if (args.nThreads > 1) {
+    convertEventsParallel(lcreader, nEvt, args.nThreads, patching ? &colPatcher : nullptr, collsToConvert, writer);
+  }
+  else {
+    LCIO2EDM4hepConv::EventConverter converter {};
+    for (auto i = 0u; i < nEvt; ++i) {
+      if (i % 10 == 0) {
+        std::cout << "processing Event: " << i << std::endl;
+      }
+      auto evt = lcreader.readNextEvent();
+      // Patching the Event to make sure all events contain the same Collections.
+      if (patching == true) {
+        colPatcher.patchCollections(evt.get());
+      }
+      const auto edmEvent = converter.convert(evt.get(), collsToConvert);
+      writer.writeFrame(edmEvent, "events");
     }
-    const auto edmEvent = LCIO2EDM4hepConv::convertEvent(evt, collsToConvert);
-    writer.writeFrame(edmEvent, "events");
   }
 
   writer.finish();
@@ -0,0 +1,111 @@
+#include "BenchmarkUtils.h"
+
+#include "k4EDM4hep2LcioConv/TaskScheduler.h"
+#include "k4EDM4hep2LcioConv/k4Lcio2EDM4hepConv.h"
+
+#include <IMPL/LCCollectionVec.h>
+#include <IMPL/SimCalorimeterHitImpl.h>
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Simple benchmark comparing the sequential conversion of a large collection of
+// LCIO SimCalorimeterHits with the conversion in parallel chunks, which is used
+// when the conversion is run from within a task of a TaskScheduler. Both have
+// to give the same results.
+//
+// Usage: benchmark_chunked_conversion [nHits] [nThreads] [nRepetitions]
+//
+// nHits has to be large enough for the chunked conversion to kick in
+
+using HitMapT = decltype(LCIO2EDM4hepConv::LcioEdmTypeMapping::simCaloHits);
+
+bool sameHits(
+  const edm4hep::SimCalorimeterHitCollection& lhs,
+  const HitMapT& lhsMap,
+  const edm4hep::SimCalorimeterHitCollection& rhs,
+  const HitMapT& rhsMap)
+{
+  if (lhs.size() != rhs.size() || lhsMap.size() != rhsMap.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < lhs.size(); ++i) {
+    const auto l = lhs[i];
+    const auto r = rhs[i];
+    if (
+      l.getCellID() != r.getCellID() || l.getEnergy() != r.getEnergy() || l.getPosition().x != r.getPosition().x ||
+      l.getPosition().y != r.getPosition().y || l.getPosition().z != r.getPosition().z) {
+      return false;
+    }
+  }
+  // The mappings have to point to the objects at the same positions
+  for (const auto& [lcioHit, edmHit] : lhsMap) {
+    const auto other = k4EDM4hep2LcioConv::detail::mapLookupTo(lcioHit, rhsMap);
+    if (!other || other->getObjectID().index != edmHit.getObjectID().index) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned nHits = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  const unsigned nThreads = argc > 2 ? std::stoul(argv[2]) : 4;
+  const unsigned nReps = argc > 3 ? std::stoul(argv[3]) : 5;
+
+  auto lcioColl = std::make_unique<IMPL::LCCollectionVec>(lcio::LCIO::SIMCALORIMETERHIT);
+  for (unsigned i = 0; i < nHits; ++i) {
+    auto* hit = new IMPL::SimCalorimeterHitImpl();
+    hit->setCellID0(i);
+    hit->setCellID1(i % 123);
+    hit->setEnergy(0.1f * i);
+    const float position[3] = {1.0f * i, 2.0f * i, 3.0f * i};
+    hit->setPosition(position);
+    lcioColl->addElement(hit);
+  }
+
+  std::unique_ptr<edm4hep::SimCalorimeterHitCollection> serialHits;
+  HitMapT serialMap {};
+  const auto serialTime = bestOf(nReps, [&]() {
+    serialMap.clear();
+    serialHits = LCIO2EDM4hepConv::convertSimCalorimeterHits("hits", lcioColl.get(), serialMap);
+  });
+
+  k4EDM4hep2LcioConv::TaskScheduler scheduler {nThreads};
+  std::unique_ptr<edm4hep::SimCalorimeterHitCollection> chunkedHits;
+  HitMapT chunkedMap {};
+  // Make sure that the conversion actually sees the scheduler, otherwise the
+  // comparison below would simply compare two sequential conversions
+  bool runsInScheduler = true;
+  const auto chunkedTime = bestOf(nReps, [&]() {
+    k4EDM4hep2LcioConv::TaskScheduler::TaskGroup group(scheduler);
+    group.run([&]() {
+      runsInScheduler = runsInScheduler && k4EDM4hep2LcioConv::TaskScheduler::current() == &scheduler;
+      chunkedMap.clear();
+      chunkedHits = LCIO2EDM4hepConv::convertSimCalorimeterHits("hits", lcioColl.get(), chunkedMap);
+    });
+    group.wait();
+  });
+
+  std::cout << "Converting " << nHits << " SimCalorimeterHits (best of " << nReps << ", times in ms)" << std::endl;
+  std::cout << std::setw(16) << std::left << "sequential" << std::setw(14) << std::right << std::fixed
+            << std::setprecision(3) << serialTime << std::endl;
+  std::cout << std::setw(16) << std::left << ("chunked (" + std::to_string(nThreads) + ")") << std::setw(14)
+            << std::right << std::fixed << std::setprecision(3) << chunkedTime << std::endl;
+
+  if (!runsInScheduler || nHits < LCIO2EDM4hepConv::detail::chunkedConversionThreshold) {
+    std::cerr << "The chunked conversion has not been used (it needs at least "
+              << LCIO2EDM4hepConv::detail::chunkedConversionThreshold << " hits)" << std::endl;
+    return 1;
+  }
+
+  if (!sameHits(*serialHits, serialMap, *chunkedHits, chunkedMap)) {
+    std::cerr << "Converted SimCalorimeterHits differ between sequential and chunked conversion" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include "k4EDM4hep2LcioConv/MappingUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Simple benchmark comparing the insert and lookup performance of the
+// different map types that can be used for the object mappings in the LCIO to
+// EDM4hep conversion. The keys are pointers to individually heap allocated
+// objects (as is the case for LCIO objects read from file) and the mapped
+// values are handle-like types that only hold a pointer (as EDM4hep objects).
+// The "cold" numbers use a newly created map for every repetition, whereas the
+// "warm" numbers re-use a cleared map, as is the case when converting several
+// events in a row.
+//
+// Usage: benchmark_object_maps [nObjects] [nRepetitions]
+
+struct LcioLikeObject {
+  std::array<float, 24> data {};
+};
+
+struct EdmLikeHandle {
+  LcioLikeObject* obj {nullptr};
+  bool operator==(const EdmLikeHandle& other) const { return obj == other.obj; }
+};
+
+using Clock = std::chrono::steady_clock;
+
+struct Timings {
+  double insert {0};
+  double lookup {0};
+  uint64_t checksum {0};
+};
+
+template<typename MapT>
+Timings runBenchmark(
+  MapT& map,
+  const std::vector<LcioLikeObject*>& keys,
+  const std::vector<LcioLikeObject*>& lookupOrder)
+{
+  Timings timings {};
+
+  map.clear();
+  const auto startInsert = Clock::now();
+  for (auto* key : keys) {
+    k4EDM4hep2LcioConv::detail::mapInsert(key, EdmLikeHandle {key}, map);
+  }
+  const auto endInsert = Clock::now();
+
+  for (auto* key : lookupOrder) {
+    if (const auto mapped = k4EDM4hep2LcioConv::detail::mapLookupTo(key, map)) {
+      timings.checksum += reinterpret_cast<std::uintptr_t>(mapped->obj) & 0xffff;
+    }
+  }
+  const auto endLookup = Clock::now();
+
+  timings.insert = std::chrono::duration<double, std::milli>(endInsert - startInsert).count();
+  timings.lookup = std::chrono::duration<double, std::milli>(endLookup - endInsert).count();
+  return timings;
+}
+
+template<typename MapT>
+Timings bestOf(
+  unsigned nReps,
+  bool reuseMap,
+  const std::vector<LcioLikeObject*>& keys,
+  const std::vector<LcioLikeObject*>& lookupOrder)
+{
+  MapT reusedMap {};
+  if (reuseMap) {
+    runBenchmark(reusedMap, keys, lookupOrder);
+  }
+
+  Timings best {};
+  for (unsigned i = 0; i < nReps; ++i) {
+    MapT freshMap {};
+    const auto timings = runBenchmark(reuseMap ? reusedMap : freshMap, keys, lookupOrder);
+    best.insert = i == 0 ? timings.insert : std::min(best.insert, timings.insert);
+    best.lookup = i == 0 ? timings.lookup : std::min(best.lookup, timings.lookup);
+    best.checksum = timings.checksum;
+  }
+  return best;
+}
+
+void printTimings(const std::string& name, const Timings& timings)
+{
+  std::cout << std::setw(27) << std::left << name << std::setw(14) << std::right << std::fixed << std::setprecision(3)
+            << timings.insert << std::setw(14) << timings.lookup << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t nObjects = argc > 1 ? std::stoul(argv[1]) : 1000000;
+  const unsigned nReps = argc > 2 ? std::stoul(argv[2]) : 5;
+
+  std::vector<std::unique_ptr<LcioLikeObject>> objects;
+  objects.reserve(nObjects);
+  std::vector<LcioLikeObject*> keys;
+  keys.reserve(nObjects);
+  for (std::size_t i = 0; i < nObjects; ++i) {
+    keys.push_back(objects.emplace_back(std::make_unique<LcioLikeObject>()).get());
+  }
+
+  // Relations are usually resolved in a fairly random order w.r.t. the order
+  // of insertion. Look up every object three times on average
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::size_t> dist(0, nObjects - 1);
+  std::vector<LcioLikeObject*> lookupOrder;
+  lookupOrder.reserve(3 * nObjects);
+  for (std::size_t i = 0; i < 3 * nObjects; ++i) {
+    lookupOrder.push_back(keys[dist(rng)]);
+  }
+
+  std::cout << "Inserting " << nObjects << " objects and doing " << lookupOrder.size()
+            << " lookups (best of " << nReps << ", times in ms)" << std::endl;
+  std::cout << std::setw(27) << std::left << "map type" << std::setw(14) << std::right << "insert"
+            << std::setw(14) << "lookup" << std::endl;
+
+  using StdMapT = k4EDM4hep2LcioConv::MapT<LcioLikeObject*, EdmLikeHandle>;
+  using FlatMapT = k4EDM4hep2LcioConv::FlatMapT<LcioLikeObject*, EdmLikeHandle>;
+
+  for (const bool reuseMap : {false, true}) {
+    const std::string suffix = reuseMap ? " (warm)" : " (cold)";
+    const auto stdTimings = bestOf<StdMapT>(nReps, reuseMap, keys, lookupOrder);
+    printTimings("std::unordered_map" + suffix, stdTimings);
+    const auto flatTimings = bestOf<FlatMapT>(nReps, reuseMap, keys, lookupOrder);
+    printTimings("FlatMap" + suffix, flatTimings);
+
+    if (stdTimings.checksum != flatTimings.checksum) {
+      std::cerr << "Lookup results differ between the map types" << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
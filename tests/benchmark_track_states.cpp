@@ -0,0 +1,89 @@
+#include "BenchmarkUtils.h"
+
+#include "k4EDM4hep2LcioConv/k4Lcio2EDM4hepConv.h"
+
+#include <IMPL/TrackStateImpl.h>
+
+#include <algorithm>
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Simple benchmark comparing the conversion of LCIO TrackStates to EDM4hep one
+// at a time through the virtual LCIO interface (convertTrackState) with the
+// batched conversion of all of them in one go (convertTrackStates). Tracks
+// usually have (at least) four TrackStates, so that is what is used here.
+//
+// Usage: benchmark_track_states [nTracks] [nRepetitions]
+
+constexpr int nStatesPerTrack = 4;
+
+bool sameTrackStates(const std::vector<edm4hep::TrackState>& lhs, const std::vector<edm4hep::TrackState>& rhs)
+{
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const auto& l, const auto& r) {
+    return l.location == r.location && l.D0 == r.D0 && l.phi == r.phi && l.omega == r.omega && l.Z0 == r.Z0 &&
+      l.tanLambda == r.tanLambda && l.time == r.time && l.referencePoint.x == r.referencePoint.x &&
+      l.referencePoint.y == r.referencePoint.y && l.referencePoint.z == r.referencePoint.z &&
+      l.covMatrix == r.covMatrix;
+  });
+}
+
+int main(int argc, char* argv[])
+{
+  const std::size_t nTracks = argc > 1 ? std::stoul(argv[1]) : 100000;
+  const unsigned nReps = argc > 2 ? std::stoul(argv[2]) : 5;
+
+  std::vector<std::unique_ptr<IMPL::TrackStateImpl>> trackStates;
+  trackStates.reserve(nTracks * nStatesPerTrack);
+  EVENT::TrackStateVec lcioTrackStates;
+  lcioTrackStates.reserve(nTracks * nStatesPerTrack);
+  for (std::size_t i = 0; i < nTracks * nStatesPerTrack; ++i) {
+    std::array<float, 15> covMatrix {};
+    for (std::size_t j = 0; j < covMatrix.size(); ++j) {
+      covMatrix[j] = i + 0.1f * j;
+    }
+    const std::array<float, 3> refPoint = {1.0f * i, 2.0f * i, 3.0f * i};
+    lcioTrackStates.push_back(trackStates
+                                .emplace_back(std::make_unique<IMPL::TrackStateImpl>(
+                                  i % nStatesPerTrack,
+                                  0.1f * i,
+                                  0.2f * i,
+                                  0.3f * i,
+                                  0.4f * i,
+                                  0.5f * i,
+                                  covMatrix.data(),
+                                  refPoint.data()))
+                                .get());
+  }
+
+  std::vector<edm4hep::TrackState> singleStates;
+  const auto singleTime = bestOf(nReps, [&]() {
+    singleStates.clear();
+    for (const auto* trackState : lcioTrackStates) {
+      singleStates.push_back(LCIO2EDM4hepConv::convertTrackState(trackState));
+    }
+  });
+
+  std::vector<edm4hep::TrackState> batchedStates;
+  const auto batchedTime = bestOf(nReps, [&]() {
+    batchedStates.clear();
+    LCIO2EDM4hepConv::convertTrackStates(lcioTrackStates, batchedStates);
+  });
+
+  std::cout << "Converting " << lcioTrackStates.size() << " TrackStates (best of " << nReps << ", times in ms)"
+            << std::endl;
+  std::cout << std::setw(16) << std::left << "single" << std::setw(14) << std::right << std::fixed
+            << std::setprecision(3) << singleTime << std::endl;
+  std::cout << std::setw(16) << std::left << "batched" << std::setw(14) << std::right << std::fixed
+            << std::setprecision(3) << batchedTime << std::endl;
+
+  if (!sameTrackStates(singleStates, batchedStates)) {
+    std::cerr << "Converted TrackStates differ between single and batched conversion" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
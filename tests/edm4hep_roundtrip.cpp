@@ -8,10 +8,10 @@
 
 #include <iostream>
 
-#define ASSERT_SAME_OR_ABORT(type, name)                                     \
-  if (!compare(origEvent.get<type>(name), roundtripEvent.get<type>(name))) { \
-    std::cerr << "Comparison failure in " << name << std::endl;              \
-    return 1;                                                                \
+#define ASSERT_SAME_OR_ABORT(event, type, name)                     \
+  if (!compare(origEvent.get<type>(name), event.get<type>(name))) { \
+    std::cerr << "Comparison failure in " << name << std::endl;     \
+    return 1;                                                       \
   }
 
 int main()
@@ -20,11 +20,73 @@ int main()
   const auto lcioEvent = EDM4hep2LCIOConv::convEvent(origEvent);
   const auto roundtripEvent = LCIO2EDM4hepConv::convertEvent(lcioEvent.get());
 
-  ASSERT_SAME_OR_ABORT(edm4hep::CalorimeterHitCollection, "caloHits");
-  ASSERT_SAME_OR_ABORT(edm4hep::MCParticleCollection, "mcParticles");
-  ASSERT_SAME_OR_ABORT(edm4hep::SimCalorimeterHitCollection, "simCaloHits");
-  ASSERT_SAME_OR_ABORT(edm4hep::TrackCollection, "tracks");
-  ASSERT_SAME_OR_ABORT(edm4hep::TrackerHitCollection, "trackerHits");
+  ASSERT_SAME_OR_ABORT(roundtripEvent, edm4hep::CalorimeterHitCollection, "caloHits");
+  ASSERT_SAME_OR_ABORT(roundtripEvent, edm4hep::MCParticleCollection, "mcParticles");
+  ASSERT_SAME_OR_ABORT(roundtripEvent, edm4hep::SimCalorimeterHitCollection, "simCaloHits");
+  ASSERT_SAME_OR_ABORT(roundtripEvent, edm4hep::TrackCollection, "tracks");
+  ASSERT_SAME_OR_ABORT(roundtripEvent, edm4hep::TrackerHitCollection, "trackerHits");
+
+  // Converting several events with the same (stateful) converters has to give
+  // the same results every time
+  auto edmToLcioConverter = EDM4hep2LCIOConv::EventConverter {};
+  auto lcioToEdmConverter = LCIO2EDM4hepConv::EventConverter {};
+  const int nEvents = 3;
+  for (int i = 0; i < nEvents; ++i) {
+    const auto statefulLcioEvent = edmToLcioConverter.convert(origEvent);
+    const auto statefulRoundtripEvent = lcioToEdmConverter.convert(statefulLcioEvent.get());
+
+    ASSERT_SAME_OR_ABORT(statefulRoundtripEvent, edm4hep::CalorimeterHitCollection, "caloHits");
+    ASSERT_SAME_OR_ABORT(statefulRoundtripEvent, edm4hep::MCParticleCollection, "mcParticles");
+    ASSERT_SAME_OR_ABORT(statefulRoundtripEvent, edm4hep::SimCalorimeterHitCollection, "simCaloHits");
+    ASSERT_SAME_OR_ABORT(statefulRoundtripEvent, edm4hep::TrackCollection, "tracks");
+    ASSERT_SAME_OR_ABORT(statefulRoundtripEvent, edm4hep::TrackerHitCollection, "trackerHits");
+  }
+
+  // Converting the contents of an event in parallel has to give the same
+  // results as converting them sequentially. Re-use the LCIO event from the
+  // very first conversion for this
+  k4EDM4hep2LcioConv::TaskScheduler scheduler {4};
+  auto parallelConverter = LCIO2EDM4hepConv::EventConverter {scheduler};
+  for (int i = 0; i < nEvents; ++i) {
+    const auto parallelRoundtripEvent = parallelConverter.convert(lcioEvent.get());
+
+    ASSERT_SAME_OR_ABORT(parallelRoundtripEvent, edm4hep::CalorimeterHitCollection, "caloHits");
+    ASSERT_SAME_OR_ABORT(parallelRoundtripEvent, edm4hep::MCParticleCollection, "mcParticles");
+    ASSERT_SAME_OR_ABORT(parallelRoundtripEvent, edm4hep::SimCalorimeterHitCollection, "simCaloHits");
+    ASSERT_SAME_OR_ABORT(parallelRoundtripEvent, edm4hep::TrackCollection, "tracks");
+    ASSERT_SAME_OR_ABORT(parallelRoundtripEvent, edm4hep::TrackerHitCollection, "trackerHits");
+  }
+
+  // All events have the same contents, so the capacity hints from the first
+  // event should have been sufficient for all the following ones
+  for (const auto& stats : {edmToLcioConverter.capacityStats(), lcioToEdmConverter.capacityStats()}) {
+    if (stats.nEvents != nEvents || stats.nRecorded != stats.nSufficient) {
+      std::cerr << "Capacity planning did not work as expected: " << stats.nSufficient << " of " << stats.nRecorded
+                << " capacity hints were sufficient in " << stats.nEvents << " events" << std::endl;
+      return 1;
+    }
+  }
+
+  // The CellIDEncodings are taken from the metadata that is currently set,
+  // even if the same Frame object is re-used with different contents
+  auto firstMetadata = podio::Frame {};
+  firstMetadata.putParameter(podio::collMetadataParamName("caloHits", "CellIDEncoding"), std::string("system:8"));
+  auto secondMetadata = podio::Frame {};
+  secondMetadata.putParameter(podio::collMetadataParamName("caloHits", "CellIDEncoding"), std::string("layer:16"));
+
+  auto metadata = std::move(firstMetadata);
+  auto metadataConverter = EDM4hep2LCIOConv::EventConverter {metadata};
+  for (const auto& expected : {"system:8", "layer:16"}) {
+    const auto encodedEvent = metadataConverter.convert(origEvent);
+    const auto encoding =
+      encodedEvent->getCollection("caloHits")->getParameters().getStringVal(lcio::LCIO::CellIDEncoding);
+    if (encoding != expected) {
+      std::cerr << "CellIDEncoding of caloHits is '" << encoding << "', expected '" << expected << "'" << std::endl;
+      return 1;
+    }
+    metadata = std::move(secondMetadata);
+    metadataConverter.setMetadata(metadata);
+  }
 
   return 0;
 }
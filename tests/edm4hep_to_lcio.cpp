@@ -39,6 +39,20 @@ int main()
     }
   }
 
+  // Subset collections have to point to the already converted objects
+  const auto* lcioTracks = lcioEvent->getCollection("tracks");
+  const auto* lcioTracksSubset = lcioEvent->getCollection("tracksSubset");
+  if (!lcioTracksSubset->isSubset()) {
+    std::cerr << "Collection tracksSubset has not been converted to an LCIO subset collection" << std::endl;
+    return 1;
+  }
+  for (std::size_t i = 0; i < test_config::subsetTrackIdcs.size(); ++i) {
+    if (lcioTracksSubset->getElementAt(i) != lcioTracks->getElementAt(test_config::subsetTrackIdcs[i])) {
+      std::cerr << "Element " << i << " of tracksSubset does not point to the corresponding LCIO Track" << std::endl;
+      return 1;
+    }
+  }
+
   const auto objectMapping = ObjectMappings::fromEvent(lcioEvent.get(), edmEvent);
 
   for (const auto& name : edmEvent.getAvailableCollections()) {
@@ -0,0 +1,78 @@
+#include "CompareEDM4hepEDM4hep.h"
+#include "EDM4hep2LCIOUtilities.h"
+
+#include "k4EDM4hep2LcioConv/TaskScheduler.h"
+#include "k4EDM4hep2LcioConv/k4EDM4hep2LcioConv.h"
+#include "k4EDM4hep2LcioConv/k4Lcio2EDM4hepConv.h"
+
+#include "podio/Frame.h"
+
+#include <iostream>
+#include <vector>
+
+#define ASSERT_SAME_OR_ABORT(type, name)                                       \
+  if (!compare(serialEvent.get<type>(name), parallelEvent.get<type>(name))) { \
+    std::cerr << "Comparison failure in " << name << std::endl;                \
+    return 1;                                                                  \
+  }
+
+// Convert all (non-subset) data collections of the LCIO event without
+// resolving any relations
+std::vector<LCIO2EDM4hepConv::CollNamePair> convertData(
+  EVENT::LCEvent* lcioEvent,
+  LCIO2EDM4hepConv::LcioEdmTypeMapping& typeMapping)
+{
+  std::vector<LCIO2EDM4hepConv::CollNamePair> collections;
+  for (const auto& name : *lcioEvent->getCollectionNames()) {
+    auto* lcioColl = lcioEvent->getCollection(name);
+    if (lcioColl->isSubset() || lcioColl->getTypeName() == "LCRelation") {
+      continue;
+    }
+    for (auto&& coll : LCIO2EDM4hepConv::convertCollection(name, lcioColl, typeMapping)) {
+      collections.emplace_back(std::move(coll));
+    }
+  }
+  return collections;
+}
+
+podio::Frame toFrame(std::vector<LCIO2EDM4hepConv::CollNamePair>&& collections)
+{
+  podio::Frame frame;
+  for (auto&& [name, coll] : collections) {
+    frame.put(std::move(coll), name);
+  }
+  return frame;
+}
+
+int main()
+{
+  const auto origEvent = createExampleEvent();
+  const auto lcioEvent = EDM4hep2LCIOConv::convEvent(origEvent);
+
+  k4EDM4hep2LcioConv::TaskScheduler scheduler {4};
+
+  // Resolving the relations concurrently has to give exactly the same results
+  // as resolving them one type after the other. Repeat this a few times to
+  // give different interleavings a chance to show up
+  const int nRepetitions = 10;
+  for (int i = 0; i < nRepetitions; ++i) {
+    LCIO2EDM4hepConv::LcioEdmTypeMapping serialMapping;
+    auto serialColls = convertData(lcioEvent.get(), serialMapping);
+    LCIO2EDM4hepConv::resolveRelations(serialMapping);
+
+    LCIO2EDM4hepConv::LcioEdmTypeMapping parallelMapping;
+    auto parallelColls = convertData(lcioEvent.get(), parallelMapping);
+    LCIO2EDM4hepConv::resolveRelations(parallelMapping, scheduler);
+
+    const auto serialEvent = toFrame(std::move(serialColls));
+    const auto parallelEvent = toFrame(std::move(parallelColls));
+
+    ASSERT_SAME_OR_ABORT(edm4hep::CalorimeterHitCollection, "caloHits");
+    ASSERT_SAME_OR_ABORT(edm4hep::MCParticleCollection, "mcParticles");
+    ASSERT_SAME_OR_ABORT(edm4hep::SimCalorimeterHitCollection, "simCaloHits");
+    ASSERT_SAME_OR_ABORT(edm4hep::TrackCollection, "tracks");
+    ASSERT_SAME_OR_ABORT(edm4hep::TrackerHitCollection, "trackerHits");
+  }
+
+  return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef K4EDM4HEP2LCIOCONV_TEST_BENCHMARKUTILS_H
+#define K4EDM4HEP2LCIOCONV_TEST_BENCHMARKUTILS_H
+
+#include <algorithm>
+#include <chrono>
+
+using Clock = std::chrono::steady_clock;
+
+/// Run convert nReps times and return the fastest of these runs in ms
+template<typename ConvertF>
+double bestOf(unsigned nReps, ConvertF&& convert)
+{
+  double best = 0;
+  for (unsigned i = 0; i < nReps; ++i) {
+    const auto start = Clock::now();
+    convert();
+    const auto end = Clock::now();
+    const auto time = std::chrono::duration<double, std::milli>(end - start).count();
+    best = i == 0 ? time : std::min(best, time);
+  }
+  return best;
+}
+
+#endif // K4EDM4HEP2LCIOCONV_TEST_BENCHMARKUTILS_H
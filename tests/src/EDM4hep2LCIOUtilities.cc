@@ -287,6 +287,13 @@ podio::Frame createExampleEvent()
       test_config::trackTrackIdcs),
     "tracks");
 
+  auto tracksSubset = edm4hep::TrackCollection {};
+  tracksSubset.setSubsetCollection();
+  for (const auto idx : test_config::subsetTrackIdcs) {
+    tracksSubset.push_back(tracks[idx]);
+  }
+  event.put(std::move(tracksSubset), "tracksSubset");
+
   auto [tmpSimCaloHits, tmpCaloHitConts] = createSimCalorimeterHits(
     test_config::nSimCaloHits, test_config::nCaloHitContributions, mcParticles, test_config::simCaloHitMCIdcs);
   const auto& simCaloHits = event.put(std::move(tmpSimCaloHits), "simCaloHits");
@@ -46,6 +46,8 @@ namespace test_config {
   /// The tracks that should be linked, first index is the track to which the
   /// second index will be added
   const static std::vector<IdxPair> trackTrackIdcs = {{0, 2}, {1, 3}, {2, 3}, {3, 2}, {3, 0}};
+  /// The tracks that should be put into a subset collection
+  const static std::vector<std::size_t> subsetTrackIdcs = {3, 1};
 
   constexpr static int nSimCaloHits = 3;          ///< The number of SimCalorimeterHits
   constexpr static int nCaloHitContributions = 4; ///< The number of CalorimeterHit Contributions